@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+# Generates a Verilog module with a single else-if chain of the given number
+# of branches (50000 by default), to stress the parsing of conditional
+# statements:
+#
+#   ./else_if_chain.py 50000 > else_if_chain.v
+#   verilog2hif else_if_chain.v
+
+import sys
+
+
+def main():
+    branches = int(sys.argv[1]) if len(sys.argv) > 1 else 50000
+    width = max(1, (branches - 1).bit_length())
+    out = sys.stdout
+    out.write("module else_if_chain (\n")
+    out.write("    input wire [%d:0] sel,\n" % (width - 1))
+    out.write("    output reg [31:0] q\n")
+    out.write(");\n")
+    out.write("    always @(*) begin\n")
+    for i in range(branches):
+        keyword = "if" if i == 0 else "else if"
+        out.write("        %s (sel == %d'd%d) q = 32'd%d;\n" % (keyword, width, i, i))
+    out.write("        else q = 32'd0;\n")
+    out.write("    end\n")
+    out.write("endmodule\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,56 @@
+/// @file fresh_names.hpp
+/// @brief Generates names which are fresh inside a view.
+/// @copyright (c) 2024 Electronic Systems Design (ESD) Lab @ UniVR
+/// This file is distributed under the BSD 2-Clause License.
+/// See LICENSE.md for details.
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <hif/hif.hpp>
+
+/// @brief Generates names which are fresh inside the view of a given context,
+/// without growing the global name table.
+/// @details
+/// The names declared inside a view are collected the first time a name is
+/// requested for it. Fresh names are then built from the requested prefix
+/// and a per-prefix counter, skipping the names already taken.
+/// Declarations added without this generator after the collection are not
+/// seen, thus a generator must live within a single refinement step.
+class FreshNames
+{
+public:
+    FreshNames();
+    ~FreshNames();
+
+    /// @brief Returns a name which is fresh inside the view of the given context.
+    /// Outside views, the global name table is used.
+    /// @param context the object the new declaration will be added close to.
+    /// @param prefix the prefix of the name.
+    /// @param suffix the suffix of the name.
+    /// @return the fresh name.
+    std::string get(hif::Object *context, const std::string &prefix, const std::string &suffix = "");
+
+private:
+    FreshNames(const FreshNames &);
+    FreshNames &operator=(const FreshNames &);
+
+    /// @brief The names taken inside a view, and the last counter used for
+    /// each prefix.
+    struct Scope {
+        std::set<std::string> names;
+        std::map<std::string, unsigned int> counters;
+
+        Scope();
+        ~Scope();
+    };
+
+    typedef std::map<hif::View *, Scope> Scopes;
+
+    Scope &_getScope(hif::View *view);
+
+    Scopes _scopes;
+};
@@ -0,0 +1,61 @@
+/// @file operator_chains.hpp
+/// @brief Keeps the chains of associative operators balanced while parsing.
+/// @copyright (c) 2024 Electronic Systems Design (ESD) Lab @ UniVR
+/// This file is distributed under the BSD 2-Clause License.
+/// See LICENSE.md for details.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include <hif/hif.hpp>
+
+/// @brief Builds the chains of an associative operator, like a ^ b ^ ... ^ z,
+/// as balanced trees instead of the degenerate ones given by left-recursive
+/// grammar rules, which make every later recursive visit linear in depth.
+/// @details
+/// A chain of n operands is kept as a binary counter: a spine of perfect
+/// subtrees whose sizes are the binary digits of n, in decreasing order.
+/// Appending an operand merges the equal sized subtrees, so the depth stays
+/// logarithmic and the operand order is kept.
+/// Only the operand count of the chain roots is recorded, and the entry of a
+/// root is dropped as soon as the root is extended. A root which is never
+/// extended again keeps its entry until clear() is called; it is looked up
+/// only if a new expression of the same operator gets its address, and even
+/// then the chain is only regrouped, which is harmless for associative
+/// operators, and checked node by node.
+class OperatorChains
+{
+public:
+    OperatorChains();
+    ~OperatorChains();
+
+    /// @brief Appends an operand to a chain, keeping it balanced.
+    /// @param left the chain built so far, or its first operand.
+    /// @param op the associative operator.
+    /// @param right the operand to append.
+    /// @param fileName the source file name of the created expressions.
+    /// @param line the source line number of the created expressions.
+    /// @param column the source column number of the created expressions.
+    /// @return the root of the updated chain.
+    hif::Value *append(
+        hif::Value *left,
+        const hif::Operator op,
+        hif::Value *right,
+        const std::string &fileName,
+        const unsigned int line,
+        const unsigned int column);
+
+    /// @brief Forgets all the recorded chains.
+    void clear();
+
+private:
+    OperatorChains(const OperatorChains &);
+    OperatorChains &operator=(const OperatorChains &);
+
+    /// Maps each chain root to the number of operands of its chain.
+    typedef std::unordered_map<hif::Expression *, unsigned long long> Roots;
+
+    Roots _roots;
+};
@@ -0,0 +1,62 @@
+/// @file stage_checkpoints.hpp
+/// @brief Writes and resumes checkpoints of the translation pipelines.
+/// @copyright (c) 2024 Electronic Systems Design (ESD) Lab @ UniVR
+/// This file is distributed under the BSD 2-Clause License.
+/// See LICENSE.md for details.
+
+#pragma once
+
+#include <string>
+
+#include <hif/hif.hpp>
+
+/// @brief Writes the tree after a given stage of a translation pipeline, and
+/// resumes a translation from such a checkpoint.
+/// @details
+/// The completed stage is stored as a property of the system, together with
+/// a tool-specific flag needed to continue the translation (e.g. whether PSL
+/// or Verilog-AMS standard libraries are required).
+class StageCheckpoints
+{
+public:
+    /// @brief Constructor.
+    /// @param stages the stages after which a checkpoint can be written,
+    /// in execution order.
+    /// @param stagesNumber the number of stages.
+    /// @param flagProperty the property storing the tool-specific flag.
+    StageCheckpoints(const char *const *stages, const int stagesNumber, const std::string &flagProperty);
+    ~StageCheckpoints();
+
+    /// @brief Requests a checkpoint after the given stage, written next to
+    /// the output file. Raises an error if the stage is unknown.
+    void setCheckpointStage(const std::string &stage, const std::string &outputFile);
+
+    /// @brief Returns true if the given stage has not already been performed
+    /// before the checkpoint the translation is resumed from.
+    bool mustRun(const std::string &stage) const;
+
+    /// @brief Writes the checkpoint, if it has been requested after the given stage.
+    void checkpoint(hif::System *systOb, const std::string &stage, const bool flag);
+
+    /// @brief Reads back a checkpoint and sets the stage it has been written after.
+    /// @param fileName the checkpoint file.
+    /// @param flag set to the tool-specific flag stored in the checkpoint.
+    /// @return the checkpointed system.
+    hif::System *resume(const std::string &fileName, bool &flag);
+
+private:
+    StageCheckpoints(const StageCheckpoints &);
+    StageCheckpoints &operator=(const StageCheckpoints &);
+
+    int _getStageIndex(const std::string &stage) const;
+    std::string _getStageProperty(const int stage) const;
+
+    const char *const *_stages;
+    const int _stagesNumber;
+    const std::string _flagProperty;
+    /// The stage after which the checkpoint is written, and the last stage
+    /// completed by the checkpoint the translation is resumed from.
+    int _checkpointStage;
+    int _resumedStage;
+    std::string _checkpointFile;
+};
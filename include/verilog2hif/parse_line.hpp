@@ -8,6 +8,8 @@
 
 #include <hif/hif.hpp>
 
+#include "post_parsing_methods.hpp"
+
 /// @brief Class to parse the command line arguments for the Verilog2hif application.
 class Verilog2hifParseLine : public hif::application_utils::CommandLineParser
 {
@@ -38,6 +40,19 @@ public:
     /// otherwise.
     bool getStructure() const;
 
+    /// @brief Returns the level of the non-determinism check requested by
+    /// the user (off, fast or full).
+    /// @return the requested level, ndc_fast if none is given.
+    NonDeterminismCheck getNonDeterminismCheck();
+
+    /// @brief Returns the stage after which a checkpoint must be written.
+    /// @return the stage name, empty if no checkpoint is requested.
+    std::string getCheckpointStage();
+
+    /// @brief Returns the checkpoint to resume the translation from.
+    /// @return the checkpoint file name, empty if none is given.
+    std::string getResumeFile();
+
 protected:
 
     /// @brief Validates and configures the arguments.
@@ -61,6 +61,22 @@ typedef struct {
     char *exp;   ///< The exponent of the number.
 } real_number_t;
 
+/// @brief The supported built-in gate primitives.
+enum gate_type_t {
+    gate_and,
+    gate_nand,
+    gate_or,
+    gate_nor,
+    gate_xor,
+    gate_xnor,
+    gate_buf,
+    gate_not,
+    gate_bufif0,
+    gate_bufif1,
+    gate_notif0,
+    gate_notif1
+};
+
 /// @brief Data about generate procedures.
 struct module_or_generate_item_declaration_t {
     /// @brief Constructor.
@@ -452,4 +468,16 @@ struct generate_block_t {
     generate_block_t &operator=(const generate_block_t &a);
     std::string generate_block_identifier_opt;
     std::list<module_or_generate_item_t *> *module_or_generate_item_list;
-};
\ No newline at end of file
+};
+/// @brief Data about an entry of a UDP table.
+struct udp_entry_t {
+    std::string inputs; ///< The input symbols, one per input. Explicit edges are written as "(ab)".
+    char state;         ///< The current state symbol, '\0' for combinational entries.
+    char output;        ///< The output or next state symbol.
+};
+
+/// @brief Data about the body of a UDP.
+struct udp_body_t {
+    hif::Assign *initial_statement;    ///< The initial value of the output, if any.
+    std::list<udp_entry_t *> *entries; ///< The table entries.
+};
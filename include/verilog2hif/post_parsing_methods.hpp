@@ -6,6 +6,15 @@
 
 #pragma once
 
+#include <hif/hif.hpp>
+
+/// @brief Level of the non-determinism check performed on the original design.
+enum NonDeterminismCheck {
+    ndc_off,  ///< The check is skipped.
+    ndc_fast, ///< Sensitivity names are indexed once per process.
+    ndc_full  ///< Sensitivity lists are searched for every read reference.
+};
+
 /// @brief Perform the first step of the post-parsing refinements.
 /// @param o pointer to the system we are working on.
 /// @param sem the semantic we are going to use.
@@ -20,4 +29,9 @@ void performStep2Refinements(hif::System *o, hif::semantics::ILanguageSemantics
 /// @param o pointer to the system we are working on.
 /// @param sem the semantic we are going to use.
 /// @param preserveStructure if true, the structure of the AST is preserved.
-void performStep3Refinements(hif::System *o, hif::semantics::ILanguageSemantics *sem, const bool preserveStructure);
+/// @param nonDeterminismCheck the level of the non-determinism check.
+void performStep3Refinements(
+    hif::System *o,
+    hif::semantics::ILanguageSemantics *sem,
+    const bool preserveStructure,
+    const NonDeterminismCheck nonDeterminismCheck = ndc_fast);
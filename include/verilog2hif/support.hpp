@@ -30,25 +30,44 @@ extern std::string yyfilename;    ///< defined in verilog_support.cc
 extern std::ostream *msgStream;   ///< defined in verilog2hif.cc
 extern std::ostream *errorStream; ///< defined in verilog2hif.cc
 extern std::ostream *debugStream; ///< defined in verilog2hif.cc
+extern bool yytraceEnabled;       ///< defined in verilog_support.cc
+
+/// @brief Evaluates to true when grammar-rule and token tracing is active.
+/// Tracing is compiled in only when PARSER_TRACING is defined, and it is
+/// enabled at runtime by the write-parsing option.
+#ifdef PARSER_TRACING
+#define YYTRACE_ENABLED (yytraceEnabled)
+#else
+#define YYTRACE_ENABLED (false)
+#endif
 
 /////////////////////////////////////////////////////////////////
 // Properties used by fix description.
+// They are probed for every visited object, thus they are kept as
+// strings, avoiding a temporary string for each probe.
 /////////////////////////////////////////////////////////////////
 
-extern const char *PROPERTY_SENSITIVE_POS;
+extern const std::string PROPERTY_SENSITIVE_POS;
+
+extern const std::string PROPERTY_SENSITIVE_NEG;
 
-extern const char *PROPERTY_SENSITIVE_NEG;
+extern const std::string PROPERTY_TASK_NOT_AUTOMATIC;
 
-extern const char *PROPERTY_TASK_NOT_AUTOMATIC;
+extern const std::string PROPERTY_GENVAR;
 
-extern const char *PROPERTY_GENVAR;
+// Property related to StateTable: the process is sensitive to all the
+// signals it reads (i.e., @*).
+extern const std::string PROPERTY_ALL_SIGNALS;
+
+// Property related to Instance and DesignUnit: the instance has open or
+// missing port connections, and the design unit contains such instances.
+extern const std::string PROPERTY_OPEN_PORTS;
 
 // Property related to Assign. Default case (if not set): blocking assignment,
 // else (if set): non-blocking assignment.
-extern const char *NONBLOCKING_ASSIGNMENT;
-extern const char *IS_VARIABLE_TYPE;
-extern const char *HIF_ALL_SENSITIVITY;
-extern const char *INITIAL_STATEMENT;
+extern const std::string NONBLOCKING_ASSIGNMENT;
+extern const std::string IS_VARIABLE_TYPE;
+extern const std::string HIF_ALL_SENSITIVITY;
 
 /////////////////////////////////////////////////////////////////
 // Functions.
@@ -131,10 +150,20 @@ void yyerror(const char *msg, hif::Object *o = nullptr);
 /// @param o the object to print.
 void yywarning(const char *msg, hif::Object *o = nullptr);
 
+/// @brief Prints a given trace message on the debug stream.
+/// @param msg the message to print.
+/// @param o the object to print.
+void yytrace(const char *msg, hif::Object *o = nullptr);
+
 /// @brief A debug function that prints a given message.
+/// It does nothing, not even formatting, unless tracing is enabled.
 /// @param msg the message to print.
 /// @param o the object to print.
-void yydebug(const char *msg, hif::Object *o = nullptr);
+inline void yydebug(const char *msg, hif::Object *o = nullptr)
+{
+    if (YYTRACE_ENABLED)
+        yytrace(msg, o);
+}
 
 /// @brief A debug function that prints a given message.
 /// @param msg the message to print.
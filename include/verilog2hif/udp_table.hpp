@@ -0,0 +1,104 @@
+/// @file udp_table.hpp
+/// @brief Precomputes the state tables of user-defined primitives.
+/// @copyright (c) 2024 Electronic Systems Design (ESD) Lab @ UniVR
+/// This file is distributed under the BSD 2-Clause License.
+/// See LICENSE.md for details.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// @brief The state table of a user-defined primitive (UDP), precomputed
+/// into a lookup table indexed by the encoded values of its inputs.
+/// @details
+/// Logic values are encoded as 0, 1 and 2 (x, z is read as x), and a
+/// pattern of values v_0 ... v_k-1 as the number sum(v_i * 3^i).
+/// A combinational UDP is indexed by the pattern of its inputs.
+/// A sequential UDP is evaluated once per changed input, and is indexed by
+/// the pattern of the changed input position, its previous value, the
+/// current inputs and the current state, where the position is the most
+/// significant digit.
+/// Level-sensitive entries take precedence over edge-sensitive ones, and
+/// patterns matched by no entry give x.
+class UdpTable
+{
+public:
+    /// @brief The encoding of the logic values.
+    enum LogicCode { CODE_ZERO = 0, CODE_ONE = 1, CODE_X = 2, CODES = 3 };
+
+    /// @brief Constructor.
+    /// @param inputs the number of inputs.
+    /// @param sequential <tt>true</tt> if the UDP is sequential.
+    UdpTable(const std::size_t inputs, const bool sequential);
+    ~UdpTable();
+
+    /// @brief Adds an entry of the state table.
+    /// @param inputs the input symbols as returned by the lexer in table
+    /// mode, one per input. Explicit edges are written as "(ab)".
+    /// @param state the current state symbol, '\\0' for combinational UDPs.
+    /// @param output the output or next state symbol.
+    /// @return an error message, empty if the entry is well formed.
+    std::string addEntry(const std::string &inputs, const char state, const char output);
+
+    /// @brief Returns the number of entries of the lookup table.
+    unsigned long long getSize() const;
+
+    /// @brief Computes the lookup table.
+    /// @return one of '0', '1' or 'X' per encoded pattern.
+    std::string compile() const;
+
+    /// @brief Returns 3^exponent.
+    static unsigned long long getWeight(const std::size_t exponent);
+
+private:
+    UdpTable(const UdpTable &);
+    UdpTable &operator=(const UdpTable &);
+
+    /// @brief An input column of an entry, with the sets of previous and
+    /// current values it matches as bit masks of LogicCode.
+    struct Column {
+        Column();
+        ~Column();
+
+        unsigned char previous; ///< Matched previous values, edges only.
+        unsigned char current;  ///< Matched current values.
+        bool isEdge;            ///< Whether the column is an edge.
+    };
+
+    /// @brief An entry of the state table.
+    struct Entry {
+        Entry();
+        ~Entry();
+
+        std::vector<Column> inputs; ///< The input columns.
+        std::size_t edge;           ///< The edge column, or the input count.
+        unsigned char state;        ///< Matched current states.
+        char output;                ///< The output symbol.
+    };
+
+    typedef std::vector<unsigned int> Pattern;
+
+    /// @brief Returns the matched values of a level symbol, 0 if unknown.
+    static unsigned char _getLevelMask(const char symbol);
+
+    /// @brief Gets the matched values of an edge symbol.
+    /// @return <tt>false</tt> if the symbol is unknown.
+    static bool _getEdgeMasks(const char symbol, unsigned char &previous, unsigned char &current);
+
+    /// @brief Returns the output symbol of the first entry matching the
+    /// given values, '\\0' if none.
+    /// @param changed the changed input, or the input count for level entries.
+    char _match(const std::size_t changed, const unsigned int previous, const Pattern &inputs, const unsigned int state)
+        const;
+
+    /// @brief Returns the table symbol of an output, given the current state.
+    static char _getTableSymbol(const char output, const unsigned int state);
+
+    /// The number of inputs.
+    const std::size_t _inputs;
+    /// Whether the UDP is sequential.
+    const bool _sequential;
+    /// The entries, in declaration order.
+    std::vector<Entry> _entries;
+};
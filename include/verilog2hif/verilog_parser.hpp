@@ -7,9 +7,12 @@
 #pragma once
 
 #include <cstdlib>
+#include <map>
 
 #include <hif/hif.hpp>
 
+#include "common/operator_chains.hpp"
+
 #include "parser_struct.hpp"
 
 class VerilogParser;
@@ -63,6 +66,20 @@ public:
         hif::BList<hif::Declaration> *paramList,
         std::list<non_port_module_item_t *> *non_port_module_item_list);
 
+    /* -----------------------------------------------------------------------
+     *  UDP DECLARATION AND INSTANTIATION
+     * -----------------------------------------------------------------------
+     */
+    void parse_UdpDeclaration(
+        char *identifier,
+        hif::BList<hif::Identifier> *udp_port_list,
+        hif::BList<hif::Declaration> *udp_port_declaration_list,
+        udp_body_t *udp_body);
+
+    /// @brief Builds the design unit of a UDP, whose table is precomputed
+    /// into a constant lookup table shared by all its instances.
+    void parse_UdpDeclaration(char *identifier, hif::BList<hif::Port> *udp_declaration_port_list, udp_body_t *udp_body);
+
     /* -----------------------------------------------------------------------
      *  PROCEDURAL BLOCKS AND ASSIGNMENTS
      * -----------------------------------------------------------------------
@@ -88,6 +105,14 @@ public:
     hif::BList<hif::Assign> *
     parse_ContinuousAssign(hif::Value *delay3_opt, hif::BList<hif::Assign> *list_of_net_assignments);
 
+    /// @brief Lowers the instances of a built-in gate primitive to
+    /// continuous assignments of the equivalent bitwise expressions.
+    /// Each instance terminal list starts with the output terminals.
+    hif::BList<hif::Assign> *parse_GateInstantiation(
+        gate_type_t gate_type,
+        hif::Value *delay,
+        std::list<hif::BList<hif::Value> *> *gate_instance_list);
+
     /* -----------------------------------------------------------------------
      *  PORT_DECLARATIONS
      * -----------------------------------------------------------------------
@@ -603,6 +628,9 @@ private:
     unsigned int _tmpCustomLineNumber;
     unsigned int _tmpCustomColumnNumber;
     bool _parseOnly;
+    /// Set when an empty named port connection is dropped, until the
+    /// instance it belongs to is built.
+    bool _openPortConnection;
     hif::TimeValue *_unit;
     hif::TimeValue *_precision;
     hif::semantics::ILanguageSemantics *_sem;
@@ -647,4 +675,23 @@ private:
     hif::Type *_composeAmsType(hif::Type *portType, hif::Type *declarationType);
 
     hif::Value *_makeValueFromFilter(analog_filter_function_arg_t *arg);
+
+    /// @brief Returns the UDP table code of the given value: 0, 1 or 2 for x and z.
+    hif::Value *_makeUdpCode(hif::Value *value);
+
+    /// @brief Returns the lookup of the given UDP table at the given index.
+    hif::Value *_makeUdpLookup(const std::string &tableName, hif::Value *index);
+
+    /// @name Associative chains.
+    /// Left-recursive rules build long chains like a ^ b ^ ... ^ z as
+    /// degenerate trees, making every later recursive visit linear in depth.
+    /// Chains of associative operators are thus kept balanced while parsing.
+    /// @{
+
+    OperatorChains _operatorChains;
+
+    bool _isChainOperator(const hif::Operator op);
+    hif::Value *_appendToChain(hif::Value *left, const hif::Operator op, hif::Value *right);
+
+    /// @}
 };
@@ -17,6 +17,18 @@ public:
 
     bool useInt32();
 
+    /// @brief Returns the name of the configuration to apply, if any.
+    /// @return the configuration name, or an empty string.
+    std::string getConfiguration();
+
+    /// @brief Returns the stage after which a checkpoint must be written.
+    /// @return the stage name, or an empty string.
+    std::string getCheckpointStage();
+
+    /// @brief Returns the checkpoint to resume the translation from.
+    /// @return the checkpoint file name, or an empty string.
+    std::string getResumeFile();
+
 private:
     /// @brief Validates and configures the arguments.
     void _validateArguments();
@@ -12,7 +12,9 @@
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <set>
 
+#include "common/operator_chains.hpp"
 #include "vhdl_parser_struct.hpp"
 
 class VhdlParser;
@@ -52,8 +54,20 @@ public:
     // Lists of definitions (architectures and packages)
     static std::list<architecture_body_t *> *du_definitions;
     static hif::BList<hif::LibraryDef> *lib_definitions;
-
-    static hif::System *buildSystemObject();
+    // Configuration declarations and specifications
+    static configuration_map_t *configurations;
+    // Logical operators overloaded by the parsed subprograms
+    static std::set<hif::Operator> overloaded_operators;
+
+    /// @brief Builds the System object from the collected declarations and
+    /// definitions. Each entity keeps only one architecture: the one selected
+    /// by the given configuration, by configuration specifications or, when
+    /// no configuration is given, by its only configuration declaration.
+    /// Otherwise, default binding (the last analyzed) is used with a warning.
+    /// All the other architectures are dropped.
+    /// @param configuration the name of the configuration to apply (if any).
+    /// @return the System object.
+    static hif::System *buildSystemObject(const std::string &configuration = "");
 
     /*
          * Public functions
@@ -514,7 +528,8 @@ private:
     VhdlTypes_t *_is_vhdl_type;
     OperatorOverloading_t *_is_operator_overloading;
 
-    configuration_map_t _configurationMap;
+    /// The balanced chains of associative operators built while parsing.
+    OperatorChains _operatorChains;
 
     void _initStandardLibraries();
 
@@ -547,4 +562,20 @@ private:
 
     /// @brief Given a component, fix all instances with default values.
     void _fixIntancesWithComponent(hif::Contents *contents, hif::View *component);
+
+    /// @brief Returns true if chains of the given operator can be regrouped,
+    /// i.e. it is a logical operator not overloaded by the parsed sources.
+    bool _isChainOperator(const hif::Operator op);
+
+    /// @brief Appends <tt>right</tt> to the chain of associative operators
+    /// <tt>left</tt>, keeping it balanced.
+    /// Left-recursive rules would otherwise build chains like
+    /// a xor b xor ... xor z as degenerate trees, linear in depth.
+    ///
+    /// @param left     the chain built so far
+    /// @param op       the associative operator
+    /// @param right    the operand to append
+    /// @return the root of the updated chain
+    ///
+    hif::Value *_appendToChain(hif::Value *left, const hif::Operator op, hif::Value *right);
 };
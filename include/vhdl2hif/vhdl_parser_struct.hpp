@@ -257,7 +257,8 @@ struct configuration_map_key_t {
     /// @brief The name of entity in which the configuration is specified.
     std::string design_unit;
 
-    /// @brief The name of the configuration.
+    /// @brief The name of the configuration. It is empty for the
+    /// configuration specifications given inside the architecture itself.
     std::string configuration;
 
     /// @brief The name of the architecture for which the configuration is
@@ -270,14 +271,11 @@ struct configuration_map_key_t {
         if (this == &other)
             return false;
 
-        if (design_unit < other.design_unit)
-            return true;
-        if (configuration < other.configuration)
-            return true;
-        if (view < other.view)
-            return true;
-
-        return false;
+        if (design_unit != other.design_unit)
+            return design_unit < other.design_unit;
+        if (configuration != other.configuration)
+            return configuration < other.configuration;
+        return view < other.view;
     }
 };
 
@@ -14,11 +14,14 @@
 
 #define HALT_ON_UNSUPPORTED_RULES
 
-#define BLOCK_STATEMENT_PROPERTY       "block_statement"
-#define AGGREGREGATE_INIDICES_PROPERTY "AGGREGREGATE_INIDICES"
-
-#define RECOGNIZED_FCALL_PROPERTY "RECOGNIZED_FUNCTION_CALL"
-#define HIF_CONCURRENT_ASSERTION  "HIF_CONCURRENT_ASSERTION"
+// Properties used by the post parsing visitors.
+// They are probed for every visited object, thus they are kept as
+// strings, avoiding a temporary string for each probe.
+extern const std::string BLOCK_STATEMENT_PROPERTY;       // defined in vhdl_support.cc
+extern const std::string AGGREGREGATE_INIDICES_PROPERTY; // defined in vhdl_support.cc
+extern const std::string RECOGNIZED_FCALL_PROPERTY;      // defined in vhdl_support.cc
+extern const std::string HIF_CONCURRENT_ASSERTION;       // defined in vhdl_support.cc
+extern const std::string OPEN_PORTS_PROPERTY;            // defined in vhdl_support.cc
 
 extern int yylineno;              // defined in vhdlParser.cc
 extern int yycolumno;             // defined in vhdl_support.cc
@@ -26,6 +29,16 @@ extern std::string yyfilename;    // defined in vhdl_support.cc
 extern std::ostream *msgStream;   // defined in vhdl2hif.cc
 extern std::ostream *errorStream; // defined in vhdl2hif.cc
 extern std::ostream *debugStream; // defined in vhdl2hif.cc
+extern bool yytraceEnabled;       // defined in vhdl_support.cc
+
+// Evaluates to true when grammar-rule and token tracing is active.
+// Tracing is compiled in only when PARSER_TRACING is defined, and it is
+// enabled at runtime by the write-parsing option.
+#ifdef PARSER_TRACING
+#define YYTRACE_ENABLED (yytraceEnabled)
+#else
+#define YYTRACE_ENABLED (false)
+#endif
 
 ///
 /// Output and debug functions
@@ -33,7 +46,14 @@ extern std::ostream *debugStream; // defined in vhdl2hif.cc
 void yyerror [[noreturn]] (VhdlParser *, const char *msg);
 void yyerror [[noreturn]] (const char *msg, hif::Object *o = nullptr);
 void yywarning(const char *msg, hif::Object *o = nullptr);
-void yydebug(const char *msg, hif::Object *o = nullptr);
+void yytrace(const char *msg, hif::Object *o = nullptr);
+
+/// @brief Prints a debug message, only when tracing is enabled.
+inline void yydebug(const char *msg, hif::Object *o = nullptr)
+{
+    if (YYTRACE_ENABLED)
+        yytrace(msg, o);
+}
 
 template <typename T> hif::BList<T> *initBList(T *p)
 {
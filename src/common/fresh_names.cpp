@@ -0,0 +1,73 @@
+/// @file fresh_names.cpp
+/// @brief
+/// @copyright (c) 2024 Electronic Systems Design (ESD) Lab @ UniVR
+/// This file is distributed under the BSD 2-Clause License.
+/// See LICENSE.md for details.
+
+#include <list>
+#include <sstream>
+
+#include "common/fresh_names.hpp"
+
+using namespace hif;
+
+FreshNames::Scope::Scope()
+    : names()
+    , counters()
+{
+    // ntd
+}
+
+FreshNames::Scope::~Scope()
+{
+    // ntd
+}
+
+FreshNames::FreshNames()
+    : _scopes()
+{
+    // ntd
+}
+
+FreshNames::~FreshNames()
+{
+    // ntd
+}
+
+std::string FreshNames::get(Object *context, const std::string &prefix, const std::string &suffix)
+{
+    View *view = dynamic_cast<View *>(context);
+    if (view == nullptr)
+        view = hif::getNearestParent<View>(context);
+    if (view == nullptr)
+        return NameTable::getInstance()->getFreshName(prefix, suffix);
+
+    Scope &scope = _getScope(view);
+    std::string name(prefix + suffix);
+    unsigned int &counter = scope.counters[prefix + suffix];
+    while (scope.names.find(name) != scope.names.end()) {
+        std::stringstream ss;
+        ss << prefix << "_" << counter << suffix;
+        name = ss.str();
+        ++counter;
+    }
+
+    scope.names.insert(name);
+    return name;
+}
+
+FreshNames::Scope &FreshNames::_getScope(View *view)
+{
+    Scopes::iterator it = _scopes.find(view);
+    if (it != _scopes.end())
+        return it->second;
+
+    Scope &scope = _scopes[view];
+    hif::HifTypedQuery<Declaration> query;
+    std::list<Declaration *> declarations;
+    hif::search(declarations, view, query);
+    for (std::list<Declaration *>::iterator i = declarations.begin(); i != declarations.end(); ++i)
+        scope.names.insert((*i)->getName());
+
+    return scope;
+}
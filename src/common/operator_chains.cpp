@@ -0,0 +1,112 @@
+/// @file operator_chains.cpp
+/// @brief
+/// @copyright (c) 2024 Electronic Systems Design (ESD) Lab @ UniVR
+/// This file is distributed under the BSD 2-Clause License.
+/// See LICENSE.md for details.
+
+#include "common/operator_chains.hpp"
+
+using namespace hif;
+
+namespace
+{
+
+Expression *_makeExpression(
+    Value *left,
+    const Operator op,
+    Value *right,
+    const std::string &fileName,
+    const unsigned int line,
+    const unsigned int column)
+{
+    Expression *e = new Expression();
+    e->setOperator(op);
+    e->setValue1(left);
+    e->setValue2(right);
+    e->setSourceFileName(fileName);
+    e->setSourceLineNumber(line);
+    e->setSourceColumnNumber(column);
+    return e;
+}
+
+bool _isNode(Value *v, const Operator op)
+{
+    Expression *e = dynamic_cast<Expression *>(v);
+    return e != nullptr && e->getOperator() == op && e->getValue1() != nullptr && e->getValue2() != nullptr;
+}
+
+} // namespace
+
+OperatorChains::OperatorChains()
+    : _roots()
+{
+    // ntd
+}
+
+OperatorChains::~OperatorChains()
+{
+    // ntd
+}
+
+Value *OperatorChains::append(
+    Value *left,
+    const Operator op,
+    Value *right,
+    const std::string &fileName,
+    const unsigned int line,
+    const unsigned int column)
+{
+    // A value which is not a recorded root is a single operand.
+    unsigned long long count = 1;
+    if (_isNode(left, op)) {
+        Roots::iterator it = _roots.find(static_cast<Expression *>(left));
+        if (it != _roots.end()) {
+            count = it->second;
+            _roots.erase(it);
+        }
+    }
+
+    // Merge the subtrees of the spine having the size of the new subtree,
+    // i.e. carry the binary digits of the count.
+    Value *current          = right;
+    unsigned long long size = 1;
+    bool balanced           = true;
+    while ((count & size) != 0) {
+        if (count == size) {
+            // The whole chain is a perfect subtree.
+            current = _makeExpression(left, op, current, fileName, line, column);
+            left    = nullptr;
+            count   = 0;
+            size *= 2;
+            break;
+        }
+
+        if (!_isNode(left, op)) {
+            balanced = false;
+            break;
+        }
+
+        // Spine node whose top subtree has the same size: split it.
+        Expression *spine = static_cast<Expression *>(left);
+        Value *rest       = spine->setValue1(nullptr);
+        Value *top        = spine->setValue2(nullptr);
+        delete spine;
+
+        current = _makeExpression(top, op, current, fileName, line, column);
+        left    = rest;
+        count -= size;
+        size *= 2;
+    }
+
+    Expression *root = nullptr;
+    if (left == nullptr)
+        root = static_cast<Expression *>(current);
+    else
+        root = _makeExpression(left, op, current, fileName, line, column);
+    // A chain not matching its count is closed: it will be a single operand.
+    if (balanced)
+        _roots[root] = count + size;
+    return root;
+}
+
+void OperatorChains::clear() { _roots.clear(); }
@@ -0,0 +1,91 @@
+/// @file stage_checkpoints.cpp
+/// @brief
+/// @copyright (c) 2024 Electronic Systems Design (ESD) Lab @ UniVR
+/// This file is distributed under the BSD 2-Clause License.
+/// See LICENSE.md for details.
+
+#include "common/stage_checkpoints.hpp"
+
+using namespace hif;
+
+StageCheckpoints::StageCheckpoints(const char *const *stages, const int stagesNumber, const std::string &flagProperty)
+    : _stages(stages)
+    , _stagesNumber(stagesNumber)
+    , _flagProperty(flagProperty)
+    , _checkpointStage(-1)
+    , _resumedStage(-1)
+    , _checkpointFile()
+{
+    // ntd
+}
+
+StageCheckpoints::~StageCheckpoints()
+{
+    // ntd
+}
+
+void StageCheckpoints::setCheckpointStage(const std::string &stage, const std::string &outputFile)
+{
+    _checkpointStage = _getStageIndex(stage);
+    if (_checkpointStage == -1)
+        messageError("Unknown checkpoint stage: " + stage, nullptr, nullptr);
+    _checkpointFile = outputFile.substr(0, outputFile.find(".hif.xml")) + "." + stage + ".checkpoint.hif.xml";
+}
+
+bool StageCheckpoints::mustRun(const std::string &stage) const { return _getStageIndex(stage) > _resumedStage; }
+
+void StageCheckpoints::checkpoint(System *systOb, const std::string &stage, const bool flag)
+{
+    const int index = _getStageIndex(stage);
+    if (index != _checkpointStage || index <= _resumedStage)
+        return;
+
+    const std::string property = _getStageProperty(index);
+    systOb->addProperty(property);
+    if (flag)
+        systOb->addProperty(_flagProperty);
+
+    hif::writeFile(_checkpointFile.c_str(), systOb, true);
+
+    systOb->removeProperty(property);
+    systOb->removeProperty(_flagProperty);
+    messageInfo("Checkpoint after stage '" + stage + "' written in: " + _checkpointFile);
+}
+
+System *StageCheckpoints::resume(const std::string &fileName, bool &flag)
+{
+    System *systOb = hif::readFile(fileName);
+    if (systOb == nullptr)
+        messageError("Cannot read checkpoint: " + fileName, nullptr, nullptr);
+
+    for (int i = 0; i < _stagesNumber; ++i) {
+        const std::string property = _getStageProperty(i);
+        if (!systOb->checkProperty(property))
+            continue;
+        _resumedStage = i;
+        systOb->removeProperty(property);
+    }
+
+    if (_resumedStage == -1)
+        messageError("Not a translation checkpoint: " + fileName, nullptr, nullptr);
+
+    flag = systOb->checkProperty(_flagProperty);
+    systOb->removeProperty(_flagProperty);
+
+    messageInfo(std::string("Resuming translation after stage '") + _stages[_resumedStage] + "'");
+    return systOb;
+}
+
+int StageCheckpoints::_getStageIndex(const std::string &stage) const
+{
+    for (int i = 0; i < _stagesNumber; ++i) {
+        if (stage == _stages[i])
+            return i;
+    }
+    return -1;
+}
+
+std::string StageCheckpoints::_getStageProperty(const int stage) const
+{
+    return std::string("CHECKPOINT_STAGE_") + _stages[stage];
+}
@@ -5,6 +5,7 @@
 /// See LICENSE.md for details.
 
 #include <algorithm>
+#include <vector>
 
 #include <hif/hif.hpp>
 
@@ -23,6 +24,17 @@ public:
     typedef std::map<hif::Variable *, ObjectSet> GenVars;
     typedef std::list<hif::Variable *> GenVarsSeq;
 
+    /// @brief The port and template parameter names of a module, in
+    /// declaration order.
+    struct FormalNames {
+        std::vector<std::string> ports;
+        std::vector<std::string> parameters;
+
+        FormalNames();
+        ~FormalNames();
+    };
+    typedef std::map<std::string, FormalNames> FormalNamesMap;
+
     FixDescription_1(hif::semantics::ILanguageSemantics *sem);
     virtual ~FixDescription_1();
     int AfterVisit(hif::Object &o);
@@ -61,6 +73,19 @@ private:
 
     void _fixParameterNames(hif::Object *call, hif::BList<hif::ParameterAssign> &actuals);
 
+    /// @brief Returns the formal names of the module instantiated by the given
+    /// instance. They are collected once per module, since gate-level netlists
+    /// instantiate few modules many times.
+    /// @param o the instance.
+    /// @param uncached filled and returned when the instance does not
+    /// reference a view.
+    const FormalNames &_getFormalNames(hif::Instance &o, FormalNames &uncached);
+
+    /// @brief Records the instance in its design unit if it has open or
+    /// missing port connections, so that only the design units recorded
+    /// need open ports to be bound.
+    void _recordOpenPorts(hif::Instance &o, const FormalNames &names);
+
     /// @brief Reference to AMS types are modeled as hif::TypeReference at parsing time.
     /// Here refining them as hif::ViewReference.
     bool _fixAMSDisciplines(hif::TypeReference *o);
@@ -93,9 +118,22 @@ private:
     hif::Trash _finalTrash;
     GenVars _genVars;
     GenVarsSeq _genVarsSeq;
+    FormalNamesMap _formalNames;
     bool _insideStandard;
 };
 
+FixDescription_1::FormalNames::FormalNames()
+    : ports()
+    , parameters()
+{
+    // ntd
+}
+
+FixDescription_1::FormalNames::~FormalNames()
+{
+    // ntd
+}
+
 FixDescription_1::FixDescription_1(hif::semantics::ILanguageSemantics *sem)
     : _sem(sem)
     , _factory(sem)
@@ -104,6 +142,7 @@ FixDescription_1::FixDescription_1(hif::semantics::ILanguageSemantics *sem)
     , _finalTrash()
     , _genVars()
     , _genVarsSeq()
+    , _formalNames()
     , _insideStandard(false)
 {
     hif::application_utils::initializeLogHeader("VERILOG2HIF", "FixDescription_1");
@@ -511,45 +550,65 @@ int FixDescription_1::visitForGenerate(hif::ForGenerate &o)
 
 int FixDescription_1::visitInstance(hif::Instance &o)
 {
-    hif::Entity *entity_o = nullptr;
+    const std::string &none       = hif::NameTable::getInstance()->none();
+    hif::ViewReference *viewref_o = dynamic_cast<hif::ViewReference *>(o.getReferencedType());
 
-    if (o.portAssigns.size() != 0 && o.portAssigns.front()->getName() == hif::NameTable::getInstance()->none()) {
-        entity_o = hif::semantics::getDeclaration(&o, _sem);
+    const bool positionalPorts = !o.portAssigns.empty() && o.portAssigns.front()->getName() == none;
+    const bool positionalParameters =
+        viewref_o != nullptr && !viewref_o->templateParameterAssigns.empty() &&
+        viewref_o->templateParameterAssigns.front()->getName() == none;
+    FormalNames uncached;
+    if (!positionalPorts && !positionalParameters) {
+        if (viewref_o != nullptr)
+            _recordOpenPorts(o, _getFormalNames(o, uncached));
+        GuideVisitor::visitInstance(o);
+        return 0;
+    }
 
-        messageAssert(entity_o != nullptr, "hif::Declaration of instance not found", &o, nullptr);
+    const FormalNames &names = _getFormalNames(o, uncached);
+    _recordOpenPorts(o, names);
+
+    if (positionalPorts) {
         messageAssert(
-            o.portAssigns.size() == entity_o->ports.size(), "Mismatch between portAssigns and entity port size", &o,
+            o.portAssigns.size() == names.ports.size(), "Mismatch between portAssigns and entity port size", &o,
             _sem);
 
-        hif::BList<hif::PortAssign>::iterator itOnPortAssign = o.portAssigns.begin();
-
-        for (hif::BList<hif::Port>::iterator it = entity_o->ports.begin(); it != entity_o->ports.end(); ++it) {
-            hif::Port *port_o             = *it;
-            hif::PortAssign *portAssign_o = *itOnPortAssign;
-            portAssign_o->setName(port_o->getName());
-            ++itOnPortAssign;
+        std::vector<std::string>::const_iterator name = names.ports.begin();
+        for (hif::BList<hif::PortAssign>::iterator it = o.portAssigns.begin(); it != o.portAssigns.end();
+             ++it, ++name) {
+            (*it)->setName(*name);
         }
     }
 
-    hif::ViewReference *viewref_o = dynamic_cast<hif::ViewReference *>(o.getReferencedType());
-
-    if (viewref_o != nullptr && viewref_o->templateParameterAssigns.size() != 0 &&
-        viewref_o->templateParameterAssigns.front()->getName() == hif::NameTable::getInstance()->none()) {
-        if (entity_o == nullptr) {
-            entity_o = hif::semantics::getDeclaration(&o, _sem);
-        }
-
-        messageAssert(entity_o != nullptr, "hif::Declaration of instance not found", &o, nullptr);
-
-        hif::View *view_o = static_cast<hif::View *>(entity_o->getParent());
-
+    if (positionalParameters) {
         messageAssert(
-            view_o->templateParameters.size() >= viewref_o->templateParameterAssigns.size(),
+            names.parameters.size() >= viewref_o->templateParameterAssigns.size(),
             "Actual template parameters are more than formal ones", nullptr, nullptr);
 
-        hif::manipulation::sortParameters(
-            viewref_o->templateParameterAssigns, view_o->templateParameters, true,
-            hif::manipulation::SortMissingKind::NOTHING, _sem);
+        bool allPositional = true;
+        for (hif::BList<hif::TPAssign>::iterator it = viewref_o->templateParameterAssigns.begin();
+             it != viewref_o->templateParameterAssigns.end(); ++it) {
+            if ((*it)->getName() == none)
+                continue;
+            allPositional = false;
+            break;
+        }
+
+        if (allPositional) {
+            // Already in declaration order: naming them is enough.
+            std::vector<std::string>::const_iterator name = names.parameters.begin();
+            for (hif::BList<hif::TPAssign>::iterator it = viewref_o->templateParameterAssigns.begin();
+                 it != viewref_o->templateParameterAssigns.end(); ++it, ++name) {
+                (*it)->setName(*name);
+            }
+        } else {
+            hif::Entity *entity_o = hif::semantics::getDeclaration(&o, _sem);
+            messageAssert(entity_o != nullptr, "hif::Declaration of instance not found", &o, nullptr);
+            hif::View *view_o = static_cast<hif::View *>(entity_o->getParent());
+            hif::manipulation::sortParameters(
+                viewref_o->templateParameterAssigns, view_o->templateParameters, true,
+                hif::manipulation::SortMissingKind::NOTHING, _sem);
+        }
     }
 
     GuideVisitor::visitInstance(o);
@@ -726,6 +785,48 @@ void FixDescription_1::_fixParameterNames(hif::Object *call, hif::BList<hif::Par
     }
 }
 
+const FixDescription_1::FormalNames &FixDescription_1::_getFormalNames(hif::Instance &o, FormalNames &uncached)
+{
+    hif::ViewReference *viewref_o = dynamic_cast<hif::ViewReference *>(o.getReferencedType());
+    std::string key;
+    if (viewref_o != nullptr) {
+        key                              = viewref_o->getDesignUnit() + "::" + viewref_o->getName();
+        FormalNamesMap::const_iterator i = _formalNames.find(key);
+        if (i != _formalNames.end())
+            return i->second;
+    }
+
+    hif::Entity *entity_o = hif::semantics::getDeclaration(&o, _sem);
+    messageAssert(entity_o != nullptr, "hif::Declaration of instance not found", &o, nullptr);
+
+    FormalNames &names = viewref_o != nullptr ? _formalNames[key] : uncached;
+    for (hif::BList<hif::Port>::iterator it = entity_o->ports.begin(); it != entity_o->ports.end(); ++it)
+        names.ports.push_back((*it)->getName());
+
+    hif::View *view_o = dynamic_cast<hif::View *>(entity_o->getParent());
+    if (view_o != nullptr) {
+        for (hif::BList<hif::Declaration>::iterator it = view_o->templateParameters.begin();
+             it != view_o->templateParameters.end(); ++it) {
+            names.parameters.push_back((*it)->getName());
+        }
+    }
+
+    return names;
+}
+
+void FixDescription_1::_recordOpenPorts(hif::Instance &o, const FormalNames &names)
+{
+    if (o.checkProperty(PROPERTY_OPEN_PORTS) || o.portAssigns.size() < names.ports.size()) {
+        hif::Object *scope = hif::getNearestParent<hif::DesignUnit>(&o);
+        if (scope == nullptr)
+            scope = hif::getNearestParent<hif::System>(&o);
+        if (scope != nullptr)
+            scope->addProperty(PROPERTY_OPEN_PORTS);
+    }
+
+    o.removeProperty(PROPERTY_OPEN_PORTS);
+}
+
 template <typename T> void FixDescription_1::_fixSystemTaskCalls(T *call)
 {
     std::string callName(call->getName());
@@ -812,13 +913,26 @@ bool FixDescription_1::_isConstantExpr(hif::Value *v)
 
 void FixDescription_1::_fixAllSignalsSesitivity(hif::StateTable *o)
 {
-    if (!o->checkProperty("ALL_SIGNALS"))
+    if (!o->checkProperty(PROPERTY_ALL_SIGNALS))
         return;
-    o->removeProperty("ALL_SIGNALS");
+    o->removeProperty(PROPERTY_ALL_SIGNALS);
 
     typedef std::list<hif::Object *> List;
     List list;
     hif::semantics::collectSymbols(list, o, _sem);
+
+    // Declarations already considered, either added or discarded: each one
+    // is checked once, and only its first read is copied into the sensitivity.
+    DeclarationSet seen;
+    for (hif::BList<hif::Value>::iterator i = o->sensitivity.begin(); i != o->sensitivity.end(); ++i) {
+        hif::Identifier *id = dynamic_cast<hif::Identifier *>(*i);
+        if (id == nullptr)
+            continue;
+        auto decl = hif::semantics::getDeclaration(id, _sem);
+        if (decl != nullptr)
+            seen.insert(decl);
+    }
+
     for (List::iterator i = list.begin(); i != list.end(); ++i) {
         hif::Value *v = dynamic_cast<hif::Value *>(*i);
         if (v == nullptr)
@@ -834,6 +948,8 @@ void FixDescription_1::_fixAllSignalsSesitivity(hif::StateTable *o)
 
         auto decl = hif::semantics::getDeclaration(v, _sem);
         messageAssert(decl != nullptr, "Unable to get declaration.", v, _sem);
+        if (!seen.insert(decl).second)
+            continue;
         auto ddecl = dynamic_cast<hif::DataDeclaration *>(decl);
         if (ddecl == nullptr)
             continue;
@@ -850,10 +966,7 @@ void FixDescription_1::_fixAllSignalsSesitivity(hif::StateTable *o)
                 continue;
         }
 
-        hif::Value *val = hif::copy(v);
-        hif::manipulation::AddUniqueObjectOptions addOpt;
-        addOpt.deleteIfNotAdded = true;
-        hif::manipulation::addUniqueObject(val, o->sensitivity, addOpt);
+        o->sensitivity.push_back(hif::copy(v));
     }
 }
 
@@ -9,6 +9,7 @@
 
 #include <hif/hif.hpp>
 
+#include "common/fresh_names.hpp"
 #include "verilog2hif/post_parsing_methods.hpp"
 #include "verilog2hif/support.hpp"
 
@@ -274,6 +275,7 @@ private:
     hif::semantics::ILanguageSemantics *_sem;
 
     hif::HifFactory _factory;
+    FreshNames _freshNames;
 
     View *_currentView;
     System *_currentSystem;
@@ -285,6 +287,7 @@ FixDescription_2::FixDescription_2(RefMap &refMap, hif::semantics::ILanguageSema
     : _refMap(refMap)
     , _sem(sem)
     , _factory(sem)
+    , _freshNames()
     , _currentView(nullptr)
     , _currentSystem(nullptr)
     , _addedDefaultTimeScale(false)
@@ -691,7 +694,7 @@ int FixDescription_2::visitPortAssign(PortAssign &o)
     // create a support signal and related continuos assign.
 
     Signal *sig = new Signal();
-    sig->setName(NameTable::getInstance()->getFreshName(p->getName(), "_partial_sig"));
+    sig->setName(_freshNames.get(&o, p->getName(), "_partial_sig"));
     sig->setType(hif::copy(paType));
     Port *instPort = hif::manipulation::instantiate(&o, _sem);
     if (instPort != nullptr && instPort->getValue() != nullptr) {
@@ -825,7 +828,7 @@ void FixDescription_2::_splitInitialProcesses(Contents *c, InitialProcesses &ini
         // - moving in it all actions after first wrong statement
         // - setting dont-initialize flag to false
         StateTable *splitted = _factory.stateTable(
-            NameTable::getInstance()->getFreshName(st->getName()), _factory.noDeclarations(), _factory.noActions(),
+            _freshNames.get(c, st->getName()), _factory.noDeclarations(), _factory.noActions(),
             false, pf_hdl);
 
         splitted->states.front()->actions.merge(afterWrongStatementActions);
@@ -4,11 +4,18 @@
 /// This file is distributed under the BSD 2-Clause License.
 /// See LICENSE.md for details.
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <hif/hif.hpp>
 
+#include "common/fresh_names.hpp"
 #include "verilog2hif/post_parsing_methods.hpp"
 #include "verilog2hif/support.hpp"
 
@@ -105,9 +112,66 @@ bool _checkSubNodeOfTop(Port *p, Views &topViews)
     return false;
 }
 
+typedef std::vector<StateTable *> Processes;
+
+/// @brief Returns the key grouping the processes that can be merged, or an
+/// empty string if the process cannot be merged: its contents, whether it
+/// is initialized and its sorted sensitivity names.
+std::string _getProcessGroupKey(StateTable *st)
+{
+    if (st->states.size() != 1 || !st->declarations.empty() || !st->sensitivityPos.empty() ||
+        !st->sensitivityNeg.empty())
+        return "";
+
+    std::set<std::string> names;
+    for (BList<Value>::iterator i = st->sensitivity.begin(); i != st->sensitivity.end(); ++i) {
+        Identifier *id = dynamic_cast<Identifier *>(*i);
+        if (id == nullptr)
+            return "";
+        names.insert(id->getName());
+    }
+
+    std::stringstream key;
+    key << static_cast<void *>(st->getParent()) << (st->getDontInitialize() ? ":d" : ":i");
+    for (std::set<std::string>::iterator i = names.begin(); i != names.end(); ++i)
+        key << ":" << *i;
+    return key.str();
+}
+
+/// @brief Merges the processes of the same contents having the same
+/// sensitivity, then updates the references of the remaining ones.
+void _mergeProcesses(Processes &processes, RefMap &refMap, hif::semantics::ILanguageSemantics *sem)
+{
+    std::map<std::string, StateTable *> groups;
+    Processes merged;
+    for (Processes::iterator i = processes.begin(); i != processes.end(); ++i) {
+        StateTable *st         = *i;
+        const std::string key  = _getProcessGroupKey(st);
+        StateTable *&groupHead = groups[key];
+        if (key.empty() || groupHead == nullptr) {
+            if (!key.empty())
+                groupHead = st;
+            merged.push_back(st);
+            continue;
+        }
+
+        // The actions are non-blocking assignments, thus their order does not matter.
+        groupHead->states.front()->actions.merge(st->states.front()->actions);
+        st->replace(nullptr);
+        delete st;
+    }
+
+    for (Processes::iterator i = merged.begin(); i != merged.end(); ++i)
+        hif::semantics::getAllReferences(refMap, sem, *i);
+}
+
 void _fixOutputPorts(Views &topViews, RefMap &refMap, hif::semantics::ILanguageSemantics *sem)
 {
     hif::HifFactory factory(sem);
+    FreshNames freshNames;
+    std::vector<Assign *> globalAssigns;
+    // The same assign may drive several output ports, e.g. {co, s} = a + b.
+    std::unordered_set<Assign *> collectedAssigns;
 
     // Output ports assigned by continuous assignments are replaced with explicit
     // processes.
@@ -170,15 +234,10 @@ void _fixOutputPorts(Views &topViews, RefMap &refMap, hif::semantics::ILanguageS
                 GlobalAction *gact = hif::getNearestParent<GlobalAction>(symb);
                 if (gact == nullptr)
                     continue;
-                std::set<StateTable *> list;
-                hif::manipulation::transformGlobalActions(ass, list, sem);
-                // Update references
-                for (std::set<StateTable *>::iterator k = list.begin(); k != list.end(); ++k) {
-                    StateTable *st = *k;
-                    // Ref design: openCores/log2
-                    //st->setDontInitialize(true);
-                    hif::semantics::getAllReferences(refMap, sem, st);
-                }
+                // Transformed once all the ports have been fixed, since
+                // their reads may still be renamed.
+                if (collectedAssigns.insert(ass).second)
+                    globalAssigns.push_back(ass);
             }
         } else {
             // There are some reads, and also some blocking/continuous assignments.
@@ -186,7 +245,7 @@ void _fixOutputPorts(Views &topViews, RefMap &refMap, hif::semantics::ILanguageS
             // update the output port.
             // Ref design: openCores/or1200_top
             Signal *sig = new Signal();
-            sig->setName(NameTable::getInstance()->getFreshName(p->getName(), "_out_sig"));
+            sig->setName(freshNames.get(p, p->getName(), "_out_sig"));
             sig->setType(hif::copy(p->getType()));
             sig->setValue(hif::copy(p->getValue()));
             hif::manipulation::addDeclarationInContext(sig, p);
@@ -228,6 +287,19 @@ void _fixOutputPorts(Views &topViews, RefMap &refMap, hif::semantics::ILanguageS
         }
     }
 
+    // Thousands of continuous assignments to output ports would give as many
+    // single-assignment processes: they are merged by sensitivity, and the
+    // references are updated once.
+    Processes processes;
+    for (std::vector<Assign *>::iterator i = globalAssigns.begin(); i != globalAssigns.end(); ++i) {
+        std::set<StateTable *> list;
+        hif::manipulation::transformGlobalActions(*i, list, sem);
+        // Ref design: openCores/log2
+        //st->setDontInitialize(true);
+        processes.insert(processes.end(), list.begin(), list.end());
+    }
+    _mergeProcesses(processes, refMap, sem);
+
     messageWarningList(
         true,
         "Found at least one output port assigned by continuous"
@@ -375,6 +447,7 @@ void _splitLogicConesLoops(System *system, RefMap &refMap, hif::semantics::ILang
     DataDeclarations declarations;
     DeclarationTokens declarationTokens;
     TokenNames tokenNames;
+    FreshNames freshNames;
     for (QueryResults::iterator i = assigns.begin(); i != assigns.end(); ++i) {
         Assign *ass          = *i;
         Value *tgtValue      = ass->getLeftHandSide();
@@ -387,7 +460,7 @@ void _splitLogicConesLoops(System *system, RefMap &refMap, hif::semantics::ILang
         ValueSet &valueSet = declarationTokens[tgtDataDecl];
         std::stringstream ss;
         ss << tgtDataDecl->getName() << "_partial" << valueSet.size();
-        std::string name = hif::NameTable::getInstance()->getFreshName(ss.str());
+        std::string name = freshNames.get(tgtDataDecl, ss.str());
         valueSet.insert(tgtValue);
         tokenNames[tgtValue] = name;
     }
@@ -451,47 +524,76 @@ void _splitLogicConesLoops(System *system, RefMap &refMap, hif::semantics::ILang
 // Info struct
 // ///////////////////////////////////////////////////////////////////
 
-struct InfoStruct {
-    InfoStruct();
-    ~InfoStruct();
-    InfoStruct(const InfoStruct &other);
-    InfoStruct &operator=(const InfoStruct &other);
-
+/// @brief The usage kinds of a reference to a signal or port.
+enum UsageKind {
     // Ref is port in instance binding
-    RefSet portUsing;
+    USING_PORT,
     // Ref is in process sensitivity
-    RefSet sensitivityUsing;
+    USING_SENSITIVITY,
     // Ref is used as rhs of port binding
-    RefSet bindUsing;
+    USING_BIND,
     // Ref is used in wait
-    RefSet waitUsing;
+    USING_WAIT,
     // Ref is rhs of continuous
-    RefSet rhsContinuousUsing;
+    USING_RHS_CONTINUOUS,
     // Ref is lhs of continuous
-    RefSet lhsContinuousUsing;
+    USING_LHS_CONTINUOUS,
     // Ref is lhs of non-blocking
-    RefSet lhsNonBlockingUsing;
+    USING_LHS_NONBLOCKING,
     // Ref is lhs of blocking
-    RefSet lhsBlockingUsing;
+    USING_LHS_BLOCKING,
     // Ref is read (in condition or RHS of procedural assigns or param of method call)
-    RefSet readUsing;
+    USING_READ,
+    USING_KINDS
+};
+
+typedef std::vector<Object *> RefList;
+
+/// @brief The references to a signal or port, by usage kind.
+/// @details
+/// One exists for every signal and port, thus the references are kept in a
+/// single vector tagged with their kind, with a count per kind, rather than
+/// in a set per kind. Most queries only test a kind for emptiness.
+struct InfoStruct {
+    InfoStruct();
+    ~InfoStruct();
+    InfoStruct(const InfoStruct &other);
+    InfoStruct &operator=(const InfoStruct &other);
 
     bool wasLhsContinuous;
 
     bool isOnlyInContinuousAssignments() const;
+
+    /// @brief Adds a reference of the given kind.
+    void addUsing(Object *ref, const UsageKind kind);
+    /// @brief Returns true if there is at least one reference of the given kind.
+    bool hasUsing(const UsageKind kind) const;
+    /// @brief Appends the references of the given kind, in insertion order.
+    void getUsing(const UsageKind kind, RefList &refs) const;
+    /// @brief Inserts the references of the given kind.
+    void getUsing(const UsageKind kind, RefSet &refs) const;
+    /// @brief Removes all the references of the given kind.
+    void clearUsing(const UsageKind kind);
+    /// @brief Removes the given references, whatever their kind.
+    void removeUsing(const RefSet &refs);
+    /// @brief Reserves room for the given number of further references.
+    void reserve(const std::size_t size);
+
+private:
+    struct Usage {
+        Object *ref;
+        UsageKind kind;
+    };
+    typedef std::vector<Usage> Usages;
+
+    Usages _usages;
+    unsigned int _counts[USING_KINDS];
 };
 
 InfoStruct::InfoStruct()
-    : portUsing()
-    , sensitivityUsing()
-    , bindUsing()
-    , waitUsing()
-    , rhsContinuousUsing()
-    , lhsContinuousUsing()
-    , lhsNonBlockingUsing()
-    , lhsBlockingUsing()
-    , readUsing()
-    , wasLhsContinuous(false)
+    : wasLhsContinuous(false)
+    , _usages()
+    , _counts()
 {
     // ntd
 }
@@ -502,18 +604,11 @@ InfoStruct::~InfoStruct()
 }
 
 InfoStruct::InfoStruct(const InfoStruct &other)
-    : portUsing(other.portUsing)
-    , sensitivityUsing(other.sensitivityUsing)
-    , bindUsing(other.bindUsing)
-    , waitUsing(other.waitUsing)
-    , rhsContinuousUsing(other.rhsContinuousUsing)
-    , lhsContinuousUsing(other.lhsContinuousUsing)
-    , lhsNonBlockingUsing(other.lhsNonBlockingUsing)
-    , lhsBlockingUsing(other.lhsBlockingUsing)
-    , readUsing(other.readUsing)
-    , wasLhsContinuous(other.wasLhsContinuous)
+    : wasLhsContinuous(other.wasLhsContinuous)
+    , _usages(other._usages)
+    , _counts()
 {
-    // ntd
+    std::copy(other._counts, other._counts + USING_KINDS, _counts);
 }
 
 InfoStruct &InfoStruct::operator=(const InfoStruct &other)
@@ -521,35 +616,86 @@ InfoStruct &InfoStruct::operator=(const InfoStruct &other)
     if (this == &other)
         return *this;
 
-    portUsing           = other.portUsing;
-    sensitivityUsing    = other.sensitivityUsing;
-    bindUsing           = other.bindUsing;
-    waitUsing           = other.waitUsing;
-    rhsContinuousUsing  = other.rhsContinuousUsing;
-    lhsContinuousUsing  = other.lhsContinuousUsing;
-    lhsNonBlockingUsing = other.lhsNonBlockingUsing;
-    lhsBlockingUsing    = other.lhsBlockingUsing;
-    readUsing           = other.readUsing;
-    wasLhsContinuous    = other.wasLhsContinuous;
+    wasLhsContinuous = other.wasLhsContinuous;
+    _usages          = other._usages;
+    std::copy(other._counts, other._counts + USING_KINDS, _counts);
 
     return *this;
 }
 
+void InfoStruct::addUsing(Object *ref, const UsageKind kind)
+{
+    Usage usage;
+    usage.ref  = ref;
+    usage.kind = kind;
+    _usages.push_back(usage);
+    ++_counts[kind];
+}
+
+bool InfoStruct::hasUsing(const UsageKind kind) const { return _counts[kind] != 0; }
+
+void InfoStruct::getUsing(const UsageKind kind, RefList &refs) const
+{
+    if (_counts[kind] == 0)
+        return;
+    for (Usages::const_iterator i = _usages.begin(); i != _usages.end(); ++i) {
+        if (i->kind == kind)
+            refs.push_back(i->ref);
+    }
+}
+
+void InfoStruct::getUsing(const UsageKind kind, RefSet &refs) const
+{
+    if (_counts[kind] == 0)
+        return;
+    for (Usages::const_iterator i = _usages.begin(); i != _usages.end(); ++i) {
+        if (i->kind == kind)
+            refs.insert(i->ref);
+    }
+}
+
+void InfoStruct::clearUsing(const UsageKind kind)
+{
+    if (_counts[kind] == 0)
+        return;
+    Usages::iterator last = _usages.begin();
+    for (Usages::iterator i = _usages.begin(); i != _usages.end(); ++i) {
+        if (i->kind != kind)
+            *last++ = *i;
+    }
+    _usages.erase(last, _usages.end());
+    _counts[kind] = 0;
+}
+
+void InfoStruct::removeUsing(const RefSet &refs)
+{
+    Usages::iterator last = _usages.begin();
+    for (Usages::iterator i = _usages.begin(); i != _usages.end(); ++i) {
+        if (refs.find(i->ref) == refs.end())
+            *last++ = *i;
+        else
+            --_counts[i->kind];
+    }
+    _usages.erase(last, _usages.end());
+}
+
+void InfoStruct::reserve(const std::size_t size) { _usages.reserve(_usages.size() + size); }
+
 typedef std::map<DataDeclaration *, InfoStruct> InfoMap;
 
 bool InfoStruct::isOnlyInContinuousAssignments() const
 {
-    if (!sensitivityUsing.empty())
+    if (hasUsing(USING_SENSITIVITY))
         return false;
-    if (!bindUsing.empty())
+    if (hasUsing(USING_BIND))
         return false;
-    if (!waitUsing.empty())
+    if (hasUsing(USING_WAIT))
         return false;
-    if (!lhsNonBlockingUsing.empty())
+    if (hasUsing(USING_LHS_NONBLOCKING))
         return false;
-    if (!lhsBlockingUsing.empty())
+    if (hasUsing(USING_LHS_BLOCKING))
         return false;
-    if (!readUsing.empty())
+    if (hasUsing(USING_READ))
         return false;
 
     return true;
@@ -565,12 +711,14 @@ void _calculateRequiredDeclType(
     //        const bool isOutputPort = dynamic_cast<Port*>(decl) != nullptr
     //                && static_cast<Port*>(decl)->getDirection() == dir_out;
 
-    isConnectionSignal = dynamic_cast<Port *>(decl) != nullptr || !infos.portUsing.empty() || !infos.bindUsing.empty();
+    isConnectionSignal =
+        dynamic_cast<Port *>(decl) != nullptr || infos.hasUsing(USING_PORT) || infos.hasUsing(USING_BIND);
 
-    isSignal = isConnectionSignal || !infos.sensitivityUsing.empty() || !infos.waitUsing.empty() ||
-               !infos.lhsNonBlockingUsing.empty();
+    isSignal = isConnectionSignal || infos.hasUsing(USING_SENSITIVITY) || infos.hasUsing(USING_WAIT) ||
+               infos.hasUsing(USING_LHS_NONBLOCKING);
 
-    isVariable = !infos.lhsContinuousUsing.empty() || !infos.lhsBlockingUsing.empty() || infos.wasLhsContinuous;
+    isVariable =
+        infos.hasUsing(USING_LHS_CONTINUOUS) || infos.hasUsing(USING_LHS_BLOCKING) || infos.wasLhsContinuous;
 }
 
 void _fillInfoMap(RefMap &refMap, InfoMap &infoMap, const bool removeProperty)
@@ -582,6 +730,11 @@ void _fillInfoMap(RefMap &refMap, InfoMap &infoMap, const bool removeProperty)
         Port *port  = dynamic_cast<Port *>(decl);
         if (sig == nullptr && port == nullptr)
             continue;
+        if (i->second.empty())
+            continue;
+
+        InfoStruct &infos = infoMap[decl];
+        infos.reserve(i->second.size());
 
         // For each interesting symbol check the context and push it into the
         // related list.
@@ -593,37 +746,37 @@ void _fillInfoMap(RefMap &refMap, InfoMap &infoMap, const bool removeProperty)
             ObjectSensitivityOptions opts;
             opts.checkAll = true;
             if (dynamic_cast<PortAssign *>(symb) != nullptr) {
-                infoMap[decl].portUsing.insert(symb);
+                infos.addUsing(symb, USING_PORT);
             } else if (hif::objectIsInSensitivityList(symb)) {
-                infoMap[decl].sensitivityUsing.insert(symb);
+                infos.addUsing(symb, USING_SENSITIVITY);
             } else if (hif::getNearestParent<PortAssign>(symb) != nullptr) {
-                infoMap[decl].bindUsing.insert(symb);
+                infos.addUsing(symb, USING_BIND);
             } else if (
                 wait != nullptr &&
                 (hif::objectIsInSensitivityList(symb, opts) || hif::isSubNode(symb, wait->getCondition()))) {
-                infoMap[decl].waitUsing.insert(symb);
+                infos.addUsing(symb, USING_WAIT);
             } else if (ass != nullptr) {
                 const bool isTarget    = hif::manipulation::isInLeftHandSide(symb);
                 const bool isInGlobact = dynamic_cast<GlobalAction *>(ass->getParent()) != nullptr;
                 const bool hasBlocking = !ass->checkProperty(NONBLOCKING_ASSIGNMENT);
                 if (!isTarget && isInGlobact) {
-                    infoMap[decl].rhsContinuousUsing.insert(symb);
+                    infos.addUsing(symb, USING_RHS_CONTINUOUS);
                 } else if (isTarget && isInGlobact) {
-                    infoMap[decl].wasLhsContinuous = true;
-                    infoMap[decl].lhsContinuousUsing.insert(symb);
+                    infos.wasLhsContinuous = true;
+                    infos.addUsing(symb, USING_LHS_CONTINUOUS);
                 } else if (isTarget && !isInGlobact && !hasBlocking) {
                     if (removeProperty)
                         ass->removeProperty(NONBLOCKING_ASSIGNMENT);
-                    infoMap[decl].lhsNonBlockingUsing.insert(symb);
+                    infos.addUsing(symb, USING_LHS_NONBLOCKING);
                 } else if (isTarget && !isInGlobact && hasBlocking) {
-                    infoMap[decl].lhsBlockingUsing.insert(symb);
+                    infos.addUsing(symb, USING_LHS_BLOCKING);
                 } else {
                     // rhs of assign
-                    infoMap[decl].readUsing.insert(symb);
+                    infos.addUsing(symb, USING_READ);
                 }
             } else {
                 // pcall, condition of if, etc.
-                infoMap[decl].readUsing.insert(symb);
+                infos.addUsing(symb, USING_READ);
             }
         }
     }
@@ -649,7 +802,9 @@ void _generateLogicConesGraph(InfoMap &infoMap, LogicGraph &logicGraph, hif::sem
 
         // The graph is related to target of continuous assigns,
         // between the target and its source symbols
-        for (RefSet::iterator j = info.lhsContinuousUsing.begin(); j != info.lhsContinuousUsing.end(); ++j) {
+        RefList lhsContinuousUsing;
+        info.getUsing(USING_LHS_CONTINUOUS, lhsContinuousUsing);
+        for (RefList::iterator j = lhsContinuousUsing.begin(); j != lhsContinuousUsing.end(); ++j) {
             Object *symb = *j;
             Assign *ass  = hif::getNearestParent<Assign>(symb);
             messageAssert(ass != nullptr, "Unexpected scope", symb, sem);
@@ -679,11 +834,11 @@ void _generateLogicConesGraph(InfoMap &infoMap, LogicGraph &logicGraph, hif::sem
                 if (sig != nullptr) {
                     InfoStruct &infos       = infoMap[sig];
                     /*
-                    if (infos.lhsBlockingUsing.empty()
-                        && infos.lhsContinuousUsing.empty()
-                        && infos.lhsNonBlockingUsing.empty()
-                        && infos.bindUsing.empty()
-                        && infos.portUsing.empty()
+                    if (!infos.hasUsing(USING_LHS_BLOCKING)
+                        && !infos.hasUsing(USING_LHS_CONTINUOUS)
+                        && !infos.hasUsing(USING_LHS_NONBLOCKING)
+                        && !infos.hasUsing(USING_BIND)
+                        && !infos.hasUsing(USING_PORT)
                         )
                         */
                     bool isConnectionSignal = false;
@@ -723,7 +878,7 @@ void _generateLogicConesGraph(InfoMap &infoMap, LogicGraph &logicGraph, hif::sem
         // - custom/test_assigns
         if (hasOnlyConstantDrivers) {
             info.wasLhsContinuous = false;
-            info.lhsContinuousUsing.clear();
+            info.clearUsing(USING_LHS_CONTINUOUS);
         }
     }
 }
@@ -739,8 +894,10 @@ void _generateConeFunctions(
     hif::HifFactory f(sem);
 
     // Used to ensure same order of cones declarations.
+    // Cone names are fresh inside their view only, thus the key is qualified.
     typedef std::map<std::string, Procedure *> Cones;
     Cones cones;
+    FreshNames freshNames;
 
     for (LogicList::iterator i = sortedGraph.begin(); i != sortedGraph.end(); ++i) {
         DataDeclaration *decl = *i;
@@ -757,16 +914,17 @@ void _generateConeFunctions(
             continue;
         // Means: signal read by continuous, but written only by processes or modules.
         // No need of cone.
-        if (infos.lhsContinuousUsing.empty())
+        if (!infos.hasUsing(USING_LHS_CONTINUOUS))
             continue;
 
         // decl is used by processes (or in other places),
         // and therefore it must have its cone procedure.
-        std::string pName = hif::NameTable::getInstance()->getFreshName((std::string("hif_cone_") + decl->getName()));
+        std::string pName = freshNames.get(decl, std::string("hif_cone_") + decl->getName());
         Procedure *cone   = static_cast<Procedure *>(f.subprogram(nullptr, pName, f.noTemplates(), f.noParameters()));
 
         decl->getBList()->push_back(cone);
-        cones[cone->getName()] = cone;
+        DesignUnit *du = hif::getNearestParent<DesignUnit>(decl);
+        cones[(du != nullptr ? du->getName() + "::" : std::string()) + cone->getName()] = cone;
         //hif::manipulation::addDeclarationInContext(cone, decl, false); // wrong, globact was after all decls
 
         StateTable *st = f.stateTable("hif_cone", f.noDeclarations(), f.noActions());
@@ -775,7 +933,9 @@ void _generateConeFunctions(
 
         // Inserting the contiunuous assigns,
         // since they will be then removed from the tree.
-        for (RefSet::iterator j = infos.lhsContinuousUsing.begin(); j != infos.lhsContinuousUsing.end(); ++j) {
+        RefList lhsContinuousUsing;
+        infos.getUsing(USING_LHS_CONTINUOUS, lhsContinuousUsing);
+        for (RefList::iterator j = lhsContinuousUsing.begin(); j != lhsContinuousUsing.end(); ++j) {
             Assign *ass = hif::getNearestParent<Assign>(*j);
             messageAssert(ass != nullptr, "Assign not found", *j, sem);
 
@@ -786,9 +946,9 @@ void _generateConeFunctions(
 
         // Managing case of decl using both as target of continuous and
         // target of assing (blocking or not blocking) inside any process.
-        if (!infos.lhsNonBlockingUsing.empty() || !infos.lhsBlockingUsing.empty()) {
+        if (infos.hasUsing(USING_LHS_NONBLOCKING) || infos.hasUsing(USING_LHS_BLOCKING)) {
             // adding a decl_old
-            std::string dOldName = hif::NameTable::getInstance()->getFreshName((std::string("old_") + decl->getName()));
+            std::string dOldName = freshNames.get(decl, std::string("old_") + decl->getName());
             Variable *declOld    = new Variable();
             declOld->setType(hif::copy(decl->getType()));
             declOld->setValue(hif::copy(decl->getValue()));
@@ -799,7 +959,7 @@ void _generateConeFunctions(
             Variable *declTmp = new Variable();
             declTmp->setType(hif::copy(decl->getType()));
             declTmp->setValue(hif::copy(decl->getValue()));
-            std::string dTmpName = hif::NameTable::getInstance()->getFreshName((std::string("tmp_") + decl->getName()));
+            std::string dTmpName = freshNames.get(decl, std::string("tmp_") + decl->getName());
             declTmp->setName(dTmpName);
             st->declarations.push_front(declTmp);
 
@@ -871,8 +1031,9 @@ void _generateConeFunctions(
             } else {
                 // push_front() of copy of all continuous assigns
                 InfoStruct &parentInfos = infoMap[parent];
-                for (RefSet::iterator k = parentInfos.lhsContinuousUsing.begin();
-                     k != parentInfos.lhsContinuousUsing.end(); ++k) {
+                RefList lhsContinuousUsing;
+                parentInfos.getUsing(USING_LHS_CONTINUOUS, lhsContinuousUsing);
+                for (RefList::iterator k = lhsContinuousUsing.begin(); k != lhsContinuousUsing.end(); ++k) {
                     Assign *ass = hif::getNearestParent<Assign>(*k);
                     messageAssert(ass != nullptr, "Assign not found", *k, sem);
 
@@ -941,9 +1102,9 @@ void _addConesPCalls(InfoMap &infoMap, hif::semantics::ILanguageSemantics *sem,
         InfoStruct &infos = infoMap[decl];
 
         RefSet tmpSet;
-        tmpSet.insert(infos.readUsing.begin(), infos.readUsing.end());
-        tmpSet.insert(infos.lhsBlockingUsing.begin(), infos.lhsBlockingUsing.end());
-        tmpSet.insert(infos.lhsNonBlockingUsing.begin(), infos.lhsNonBlockingUsing.end());
+        infos.getUsing(USING_READ, tmpSet);
+        infos.getUsing(USING_LHS_BLOCKING, tmpSet);
+        infos.getUsing(USING_LHS_NONBLOCKING, tmpSet);
 
         for (RefSet::iterator j = tmpSet.begin(); j != tmpSet.end(); ++j) {
             Object *symb      = *j;
@@ -1032,17 +1193,19 @@ void _fixSensitivities(
         // Fix only when target of continuous assignment is used in sensitivity of
         // processes or wait.
         InfoStruct &infos = infoMap[decl];
-        if (infos.sensitivityUsing.empty() && infos.waitUsing.empty())
+        if (!infos.hasUsing(USING_SENSITIVITY) && !infos.hasUsing(USING_WAIT))
             continue;
 
         // For each using adding top level parents in sensitivities and remove it
         // from the list.
-        for (RefSet::iterator j = infos.sensitivityUsing.begin(); j != infos.sensitivityUsing.end();) {
+        RefList sensitivityUsing;
+        infos.getUsing(USING_SENSITIVITY, sensitivityUsing);
+        infos.clearUsing(USING_SENSITIVITY);
+        for (RefList::iterator j = sensitivityUsing.begin(); j != sensitivityUsing.end(); ++j) {
             Object *ref            = *j;
             BList<Value> *sensList = hif::objectGetSensitivityList(ref);
             messageAssert(sensList != nullptr, "Cannot find parent sensitivity", ref, sem);
             sensList->removeSubTree(static_cast<Value *>(ref));
-            infos.sensitivityUsing.erase(j++);
             refMap[decl].erase(ref);
             delete ref;
             for (LogicSet::iterator k = sensMap[decl].begin(); k != sensMap[decl].end(); ++k) {
@@ -1059,13 +1222,16 @@ void _fixSensitivities(
                 addOpt.deleteIfNotAdded             = true;
                 const bool inserted                 = hif::manipulation::addUniqueObject(sensEntry, *sensList, addOpt);
                 if (inserted) {
-                    infoMap[parentNodeDecl].sensitivityUsing.insert(sensEntry);
+                    infoMap[parentNodeDecl].addUsing(sensEntry, USING_SENSITIVITY);
                     refMap[parentNodeDecl].insert(sensEntry);
                 }
             }
         }
 
-        for (RefSet::iterator j = infos.waitUsing.begin(); j != infos.waitUsing.end();) {
+        RefList waitUsing;
+        infos.getUsing(USING_WAIT, waitUsing);
+        RefSet removedWaitUsing;
+        for (RefList::iterator j = waitUsing.begin(); j != waitUsing.end(); ++j) {
             Object *ref = *j;
             ObjectSensitivityOptions opts;
             opts.checkAll          = true;
@@ -1073,7 +1239,7 @@ void _fixSensitivities(
             if (sensList == nullptr)
                 continue; // i.e. in wait condition
             sensList->removeSubTree(static_cast<Value *>(ref));
-            infos.waitUsing.erase(j++);
+            removedWaitUsing.insert(ref);
             refMap[decl].erase(ref);
             delete ref;
             for (LogicSet::iterator k = sensMap[decl].begin(); k != sensMap[decl].end(); ++k) {
@@ -1090,21 +1256,29 @@ void _fixSensitivities(
                 addOpt.deleteIfNotAdded             = true;
                 const bool inserted                 = hif::manipulation::addUniqueObject(sensEntry, *sensList, addOpt);
                 if (inserted) {
-                    infoMap[parentNodeDecl].waitUsing.insert(sensEntry);
+                    infoMap[parentNodeDecl].addUsing(sensEntry, USING_WAIT);
                     refMap[parentNodeDecl].insert(sensEntry);
                 }
             }
         }
+        infos.removeUsing(removedWaitUsing);
     }
 }
 
 void _clearContinuousAssigns(RefMap &refMap, InfoMap &infoMap, hif::semantics::ILanguageSemantics *sem)
 {
+    // Usages of read signals and ports are collected and removed once per
+    // declaration, after all assigns are gone.
+    typedef std::map<DataDeclaration *, RefSet> RemovedUsages;
+    RemovedUsages removedUsages;
+
     for (InfoMap::iterator i = infoMap.begin(); i != infoMap.end(); ++i) {
         //DataDeclaration * decl = i->first;
         InfoStruct &infos = i->second;
 
-        for (RefSet::iterator j = infos.lhsContinuousUsing.begin(); j != infos.lhsContinuousUsing.end(); ++j) {
+        RefList lhsContinuousUsing;
+        infos.getUsing(USING_LHS_CONTINUOUS, lhsContinuousUsing);
+        for (RefList::iterator j = lhsContinuousUsing.begin(); j != lhsContinuousUsing.end(); ++j) {
             Object *ref = *j;
             Assign *ass = hif::getNearestParent<Assign>(ref);
             messageAssert(ass != nullptr, "Cannot find parent assign", ref, sem);
@@ -1127,15 +1301,18 @@ void _clearContinuousAssigns(RefMap &refMap, InfoMap &infoMap, hif::semantics::I
                 if (sig == nullptr && port == nullptr)
                     continue;
 
-                infoMap[innerDecl].readUsing.erase(innerSymb);
-                infoMap[innerDecl].rhsContinuousUsing.erase(innerSymb);
+                removedUsages[innerDecl].insert(innerSymb);
             }
 
             ass->replace(nullptr);
             delete ass;
         }
 
-        infos.lhsContinuousUsing.clear();
+        infos.clearUsing(USING_LHS_CONTINUOUS);
+    }
+
+    for (RemovedUsages::iterator i = removedUsages.begin(); i != removedUsages.end(); ++i) {
+        infoMap[i->first].removeUsing(i->second);
     }
 }
 
@@ -1200,6 +1377,7 @@ void _refineToVariables(
     hif::HifFactory f(sem);
     hif::application_utils::WarningList bindWarnings;
     hif::application_utils::WarningList delayWarnings;
+    FreshNames freshNames;
 
     for (InfoMap::iterator i = infoMap.begin(); i != infoMap.end(); ++i) {
         DataDeclaration *decl = i->first;
@@ -1229,12 +1407,12 @@ void _refineToVariables(
             }
         } else // (isVariable && isSignal) || isOutputPort
         {
-            if (isConnectionSignal && !infos.bindUsing.empty()) {
+            if (isConnectionSignal && infos.hasUsing(USING_BIND)) {
                 bindWarnings.push_back(decl);
             }
 
             // mixed case
-            std::string varName = NameTable::getInstance()->getFreshName(decl->getName(), "_sig_var");
+            std::string varName = freshNames.get(decl, decl->getName(), "_sig_var");
 
             // creating support var
             Variable *var = new Variable();
@@ -1245,9 +1423,11 @@ void _refineToVariables(
             // adding after signal
             hif::manipulation::addDeclarationInContext(var, decl, false);
 
-            messageAssert(infos.lhsContinuousUsing.empty(), "Unexpected lhs of continuous", decl, sem);
+            messageAssert(!infos.hasUsing(USING_LHS_CONTINUOUS), "Unexpected lhs of continuous", decl, sem);
 
-            for (RefSet::iterator j = infos.lhsBlockingUsing.begin(); j != infos.lhsBlockingUsing.end(); ++j) {
+            RefList lhsBlockingUsing;
+            infos.getUsing(USING_LHS_BLOCKING, lhsBlockingUsing);
+            for (RefList::iterator j = lhsBlockingUsing.begin(); j != lhsBlockingUsing.end(); ++j) {
                 // 1- sig = expr  -->
                 // var[5] = expr;
                 // sig[5] <= var[5]; // only if is not inside cone
@@ -1290,8 +1470,8 @@ void _refineToVariables(
             }
 
             RefSet readUsing;
-            readUsing.insert(infos.readUsing.begin(), infos.readUsing.end());
-            readUsing.insert(infos.rhsContinuousUsing.begin(), infos.rhsContinuousUsing.end());
+            infos.getUsing(USING_READ, readUsing);
+            infos.getUsing(USING_RHS_CONTINUOUS, readUsing);
 
             for (RefSet::iterator j = readUsing.begin(); j != readUsing.end(); ++j) {
                 // Replace sig with var
@@ -1302,13 +1482,12 @@ void _refineToVariables(
             }
 
             // Adding writing of var with sig as source in case of non-blocking
-            if (!infos.lhsNonBlockingUsing.empty()) {
+            if (infos.hasUsing(USING_LHS_NONBLOCKING)) {
                 BaseContents *bc = _getBaseContents(decl);
 
                 // check if decl cones method is already creaded, otherwise create it
                 if (conesMap.find(decl) == conesMap.end()) {
-                    std::string pName =
-                        hif::NameTable::getInstance()->getFreshName((std::string("hif_cone_") + decl->getName()));
+                    std::string pName = freshNames.get(decl, std::string("hif_cone_") + decl->getName());
                     Procedure *cone =
                         static_cast<Procedure *>(f.subprogram(nullptr, pName, f.noTemplates(), f.noParameters()));
                     bc->declarations.push_back(cone);
@@ -1326,8 +1505,7 @@ void _refineToVariables(
                 // signal and variable.
 
                 // adding a decl_old
-                std::string dOldName =
-                    hif::NameTable::getInstance()->getFreshName((std::string("old_") + decl->getName()));
+                std::string dOldName = freshNames.get(decl, std::string("old_") + decl->getName());
                 Variable *declOld = new Variable();
                 declOld->setType(hif::copy(decl->getType()));
                 declOld->setValue(hif::copy(decl->getValue()));
@@ -1345,8 +1523,8 @@ void _refineToVariables(
 
             // Adding process to synchronize sig and var.
             if (!sensMap[decl].empty()) {
-                std::string name = NameTable::getInstance()->getFreshName(
-                    (std::string(var->getName()) + "_" + decl->getName() + "_sync_process"));
+                std::string name =
+                    freshNames.get(decl, std::string(var->getName()) + "_" + decl->getName() + "_sync_process");
                 StateTable *process = f.stateTable(
                     name, f.noDeclarations(),
                     f.assignAction(new Identifier(decl->getName()), new Identifier(var->getName())),
@@ -1433,9 +1611,11 @@ void _fillViewSets(
             views.insert(v);
     }
 
-    if (!infos.portUsing.empty()) {
-        PortAssign *portAss = dynamic_cast<PortAssign *>(*infos.portUsing.begin());
-        messageAssert(portAss != nullptr, "Unexpected object", *infos.portUsing.begin(), sem);
+    if (infos.hasUsing(USING_PORT)) {
+        RefList portUsing;
+        infos.getUsing(USING_PORT, portUsing);
+        PortAssign *portAss = dynamic_cast<PortAssign *>(portUsing.front());
+        messageAssert(portAss != nullptr, "Unexpected object", portUsing.front(), sem);
         PortAssign::DeclarationType *port = hif::semantics::getDeclaration(portAss, sem);
         messageAssert(port != nullptr, "Declaration not found", portAss, sem);
         View *v = hif::getNearestParent<View>(decl);
@@ -1443,7 +1623,9 @@ void _fillViewSets(
             views.insert(v);
     }
 
-    for (RefSet::iterator i = infos.bindUsing.begin(); i != infos.bindUsing.end(); ++i) {
+    RefList bindUsing;
+    infos.getUsing(USING_BIND, bindUsing);
+    for (RefList::iterator i = bindUsing.begin(); i != bindUsing.end(); ++i) {
         Instance *inst = hif::getNearestParent<Instance>(*i);
         if (inst == nullptr)
             continue;
@@ -1478,6 +1660,175 @@ void _collectOnAssigns(InfoMap &infoMap, hif::semantics::ILanguageSemantics *sem
     }
 }
 
+/// @brief The design unit, view and instance names locating an instance.
+/// Names are used since flattening may replace the objects.
+typedef std::vector<std::string> InstancePath;
+typedef std::map<InstancePath, Instance *> InstancesByPath;
+
+/// @brief Instances of the same view with the same template parameter
+/// assigns: only the representative is flattened, and the resulting view
+/// is then reused by the others.
+struct FlatteningGroup {
+    ViewReference *original;
+    InstancePath representative;
+    std::vector<InstancePath> copies;
+};
+
+typedef std::vector<FlatteningGroup> FlatteningGroups;
+/// @brief The positions in FlatteningGroups of the groups sharing a key.
+typedef std::unordered_map<std::string, std::vector<std::size_t>> FlatteningGroupIndex;
+
+bool _getInstancePath(Instance *inst, InstancePath &path)
+{
+    // Only instances directly inside view contents have unique names.
+    View *v = hif::getNearestParent<View>(inst);
+    if (v == nullptr || v->getContents() == nullptr || inst->getParent() != v->getContents())
+        return false;
+    DesignUnit *du = dynamic_cast<DesignUnit *>(v->getParent());
+    if (du == nullptr)
+        return false;
+
+    path.clear();
+    path.push_back(du->getName());
+    path.push_back(v->getName());
+    path.push_back(inst->getName());
+    return true;
+}
+
+/// @brief Returns true if all the template arguments of the given view
+/// reference are constants. Other arguments, like parameters of the parent
+/// module, may have different values in different parents, even if they are
+/// structurally equal.
+bool _hasConstantArguments(ViewReference *viewRef)
+{
+    for (BList<TPAssign>::iterator i = viewRef->templateParameterAssigns.begin();
+         i != viewRef->templateParameterAssigns.end(); ++i) {
+        ValueTPAssign *vtpa = dynamic_cast<ValueTPAssign *>(*i);
+        if (vtpa == nullptr || dynamic_cast<ConstValue *>(vtpa->getValue()) == nullptr)
+            return false;
+    }
+    return true;
+}
+
+/// @brief Returns a key for grouping identical view references: design unit,
+/// view and constant template arguments sorted by name. Integer and bitvector
+/// values are part of the key, other constants only by name, thus equal keys
+/// must still be confirmed.
+std::string _getGroupKey(ViewReference *viewRef)
+{
+    std::vector<std::string> args;
+    for (BList<TPAssign>::iterator i = viewRef->templateParameterAssigns.begin();
+         i != viewRef->templateParameterAssigns.end(); ++i) {
+        std::stringstream arg;
+        arg << (*i)->getName() << '=';
+        Value *value = static_cast<ValueTPAssign *>(*i)->getValue();
+        if (dynamic_cast<IntValue *>(value) != nullptr)
+            arg << static_cast<IntValue *>(value)->getValue();
+        else if (dynamic_cast<BitvectorValue *>(value) != nullptr)
+            arg << static_cast<BitvectorValue *>(value)->getValue();
+        args.push_back(arg.str());
+    }
+    std::sort(args.begin(), args.end());
+
+    std::string key = std::string(viewRef->getDesignUnit()) + "::" + viewRef->getName();
+    for (std::vector<std::string>::iterator i = args.begin(); i != args.end(); ++i)
+        key += "," + *i;
+    return key;
+}
+
+void _groupViewRefs(
+    ViewRefs &viewRefs,
+    Views &views,
+    FlatteningGroups &groups,
+    hif::manipulation::FlattenDesignOptions &fopt,
+    hif::semantics::ILanguageSemantics *sem)
+{
+    FlatteningGroupIndex index;
+    for (ViewRefs::iterator i = viewRefs.begin(); i != viewRefs.end(); ++i) {
+        ViewReference *viewRef = *i;
+        Instance *inst         = dynamic_cast<Instance *>(viewRef->getParent());
+        InstancePath path;
+        // Instances inside views flattened as a whole, and instances whose
+        // arguments are not constants, are left to flattenDesign.
+        if (inst == nullptr || !_getInstancePath(inst, path) ||
+            views.find(hif::getNearestParent<View>(inst)) != views.end() || !_hasConstantArguments(viewRef)) {
+            fopt.rootInstances.insert(hif::manipulation::buildHierarchicalSymbol(viewRef, sem));
+            continue;
+        }
+
+        std::vector<std::size_t> &bucket     = index[_getGroupKey(viewRef)];
+        std::vector<std::size_t>::iterator g = bucket.begin();
+        for (; g != bucket.end(); ++g) {
+            if (hif::equals(viewRef, groups[*g].original))
+                break;
+        }
+
+        if (g != bucket.end()) {
+            groups[*g].copies.push_back(path);
+            continue;
+        }
+
+        bucket.push_back(groups.size());
+        FlatteningGroup group;
+        group.original       = hif::copy(viewRef);
+        group.representative = path;
+        groups.push_back(group);
+        fopt.rootInstances.insert(hif::manipulation::buildHierarchicalSymbol(viewRef, sem));
+    }
+}
+
+void _collectInstancesByPath(System *system, InstancesByPath &instances)
+{
+    hif::HifTypedQuery<Instance> query;
+    std::list<Instance *> results;
+    hif::search(results, system, query);
+    for (std::list<Instance *>::iterator i = results.begin(); i != results.end(); ++i) {
+        InstancePath path;
+        if (_getInstancePath(*i, path))
+            instances[path] = *i;
+    }
+}
+
+/// @brief Binds the copies of each group to the view produced by flattening
+/// its representative. Copies of groups whose representative has not been
+/// specialized are collected to be flattened one by one.
+unsigned int _reuseFlattenedViews(
+    System *system,
+    FlatteningGroups &groups,
+    hif::manipulation::FlattenDesignOptions &copiesOpt,
+    hif::semantics::ILanguageSemantics *sem)
+{
+    InstancesByPath instances;
+    _collectInstancesByPath(system, instances);
+
+    unsigned int avoided = 0;
+    for (FlatteningGroups::iterator g = groups.begin(); g != groups.end(); ++g) {
+        InstancesByPath::iterator rep = instances.find(g->representative);
+        ViewReference *flattened =
+            (rep == instances.end()) ? nullptr : dynamic_cast<ViewReference *>(rep->second->getReferencedType());
+        const bool reusable = flattened != nullptr && !hif::equals(flattened, g->original);
+
+        for (std::vector<InstancePath>::iterator i = g->copies.begin(); i != g->copies.end(); ++i) {
+            InstancesByPath::iterator copy = instances.find(*i);
+            messageAssert(copy != instances.end(), "Cannot find instance to flatten", g->original, sem);
+            Instance *inst = copy->second;
+            if (!reusable) {
+                ViewReference *viewRef = dynamic_cast<ViewReference *>(inst->getReferencedType());
+                messageAssert(viewRef != nullptr, "Unexpected referenced type", inst, sem);
+                copiesOpt.rootInstances.insert(hif::manipulation::buildHierarchicalSymbol(viewRef, sem));
+                continue;
+            }
+
+            delete inst->setReferencedType(hif::copy(flattened));
+            ++avoided;
+        }
+
+        delete g->original;
+    }
+
+    return avoided;
+}
+
 void _performPartialFlattening(
     System *system,
     Views &views,
@@ -1495,12 +1846,25 @@ void _performPartialFlattening(
         fopt.rootDUs.insert(hif::manipulation::buildHierarchicalSymbol(view, sem));
     }
 
-    for (ViewRefs::iterator i = viewRefs.begin(); i != viewRefs.end(); ++i) {
-        ViewReference *viewRef = *i;
-        fopt.rootInstances.insert(hif::manipulation::buildHierarchicalSymbol(viewRef, sem));
-    }
+    // Identical instances would be flattened into identical views:
+    // flatten one representative per group only.
+    FlatteningGroups groups;
+    _groupViewRefs(viewRefs, views, groups, fopt, sem);
 
     hif::manipulation::flattenDesign(system, sem, fopt);
+
+    hif::manipulation::FlattenDesignOptions copiesOpt;
+    copiesOpt.verbose          = true;
+    const unsigned int avoided = _reuseFlattenedViews(system, groups, copiesOpt, sem);
+    if (!copiesOpt.rootInstances.empty())
+        hif::manipulation::flattenDesign(system, sem, copiesOpt);
+
+    if (avoided != 0) {
+        std::stringstream ss;
+        ss << "Partial flattening: " << groups.size() << " flattened instance group(s), " << avoided
+           << " copy(ies) avoided.";
+        messageInfo(ss.str());
+    }
 }
 
 bool _checkTopViews(Views &views, Views &topViews)
@@ -1515,21 +1879,92 @@ bool _checkTopViews(Views &views, Views &topViews)
     return true;
 }
 
-void _performOriginalDesignChecks(RefMap &refMap, hif::semantics::ILanguageSemantics * /*sem*/)
+/// @brief A reference to a signal or port inside a process body.
+struct ProcessReference {
+    Object *symbol;
+    StateTable *process;
+    bool isTarget;
+};
+
+typedef std::vector<ProcessReference> ProcessReferences;
+typedef std::unordered_set<std::string> SensitivityNames;
+typedef std::map<StateTable *, SensitivityNames> SensitivityIndex;
+
+/// @brief Returns the process containing the given symbol, or nullptr when
+/// the symbol is outside a process or inside a process which is not checked.
+StateTable *_getCheckedProcess(Object *symbol)
+{
+    // Must be in process body
+    State *state = getNearestParent<State>(symbol);
+    if (state == nullptr)
+        return nullptr;
+    StateTable *process = dynamic_cast<StateTable *>(state->getParent());
+    SubProgram *sub     = dynamic_cast<SubProgram *>(process->getParent());
+    if (sub != nullptr)
+        return nullptr; // Too hard to check!
+    // Skip possible initial() processes:
+    if (process->getFlavour() == hif::pf_initial || process->getFlavour() == hif::pf_analog)
+        return nullptr;
+    return process;
+}
+
+/// @brief Returns the names referenced by the sensitivity lists of the given
+/// process. Names are collected once per process and then cached.
+const SensitivityNames &_getSensitivityNames(StateTable *process, SensitivityIndex &index)
+{
+    SensitivityIndex::iterator it = index.find(process);
+    if (it != index.end())
+        return it->second;
+
+    SensitivityNames &names = index[process];
+    typedef hif::HifTypedQuery<Identifier> Query;
+    Query query;
+    Query::Results results;
+    hif::search(results, process->sensitivity, query);
+    hif::search(results, process->sensitivityPos, query);
+    hif::search(results, process->sensitivityNeg, query);
+    for (Query::Results::iterator i = results.begin(); i != results.end(); ++i) {
+        names.insert((*i)->getName());
+    }
+    return names;
+}
+
+/// @brief Checks whether the given declaration is in the sensitivity of the
+/// given process, by searching all its sensitivity lists.
+bool _isInSensitivity(StateTable *process, Declaration *decl)
+{
+    typedef hif::HifTypedQuery<Identifier> Query;
+    Query query;
+    Query::Results results;
+    query.onlyFirstMatch = true;
+    query.name           = decl->getName();
+    hif::search(results, process->sensitivity, query);
+    hif::search(results, process->sensitivityPos, query);
+    hif::search(results, process->sensitivityNeg, query);
+    return !results.empty();
+}
+
+void _performOriginalDesignChecks(
+    RefMap &refMap,
+    hif::semantics::ILanguageSemantics * /*sem*/,
+    const NonDeterminismCheck checkLevel)
 {
     // Check non-determinism basic FSM-like case.
     // E.g.:
     // p1: @(...) sig = expr;
     // p2: @(...) out = sig;
     // This is NON-DETERMINISTIC when sig is not in p2 sensitivity.
+    if (checkLevel == ndc_off)
+        return;
 
-    typedef std::set<Declaration *> Declarations;
-    Declarations collectedDecls;
     typedef std::set<StateTable *> Processes;
     typedef std::map<Declaration *, Processes> ProcessesMap;
+    typedef std::map<Declaration *, ProcessReferences> CandidatesMap;
     ProcessesMap processesMap;
+    CandidatesMap candidatesMap;
 
-    // Collecting candiadate declarations
+    // Collecting candiadate declarations.
+    // The enclosing process of each reference is computed only once.
     for (RefMap::iterator i = refMap.begin(); i != refMap.end(); ++i) {
         Declaration *decl = i->first;
         RefSet &refSet    = i->second;
@@ -1539,69 +1974,58 @@ void _performOriginalDesignChecks(RefMap &refMap, hif::semantics::ILanguageSeman
             (portDecl != nullptr && portDecl->getDirection() == hif::dir_in))
             continue;
 
+        ProcessReferences references;
+        bool isCandidate = false;
         for (RefSet::iterator j = refSet.begin(); j != refSet.end(); ++j) {
-            Object *symbol = *j;
-            // Must be in process body
-            State *state   = getNearestParent<State>(symbol);
-            if (state == nullptr)
-                continue;
-            StateTable *process = dynamic_cast<StateTable *>(state->getParent());
-            SubProgram *sub     = dynamic_cast<SubProgram *>(process->getParent());
-            if (sub != nullptr)
-                continue; // Too hard to check!
-            // Skip possible initial() processes:
-            if (process->getFlavour() == hif::pf_initial || process->getFlavour() == hif::pf_analog)
+            Object *symbol      = *j;
+            StateTable *process = _getCheckedProcess(symbol);
+            if (process == nullptr)
                 continue;
+            ProcessReference ref;
+            ref.symbol   = symbol;
+            ref.process  = process;
+            ref.isTarget = hif::manipulation::isInLeftHandSide(symbol);
+            references.push_back(ref);
             // Must be written as blocking
-            const bool isTarget = hif::manipulation::isInLeftHandSide(symbol);
-            if (!isTarget)
+            if (!ref.isTarget)
                 continue;
             Assign *ass = hif::getNearestParent<Assign>(symbol);
             if (ass->checkProperty(NONBLOCKING_ASSIGNMENT))
                 continue;
             // Collecting
-            collectedDecls.insert(decl);
+            isCandidate = true;
             processesMap[decl].insert(process);
         }
+
+        if (isCandidate)
+            candidatesMap[decl].swap(references);
     }
 
     // Checking collected candiadate declarations
     hif::application_utils::WarningSet warnings;
-    for (Declarations::iterator i = collectedDecls.begin(); i != collectedDecls.end(); ++i) {
-        Declaration *decl = *i;
-        RefSet &refSet    = refMap[decl];
-        for (RefSet::iterator j = refSet.begin(); j != refSet.end(); ++j) {
-            Object *symbol = *j;
-            // Must be in process body
-            State *state   = getNearestParent<State>(symbol);
-            if (state == nullptr)
-                continue;
-            StateTable *process = dynamic_cast<StateTable *>(state->getParent());
-            SubProgram *sub     = dynamic_cast<SubProgram *>(process->getParent());
-            if (sub != nullptr)
-                continue; // Too hard to check!
-            // Skip possible initial() processes:
-            if (process->getFlavour() == hif::pf_initial || process->getFlavour() == hif::pf_analog)
-                continue;
+    SensitivityIndex sensitivityIndex;
+    for (CandidatesMap::iterator i = candidatesMap.begin(); i != candidatesMap.end(); ++i) {
+        Declaration *decl             = i->first;
+        ProcessReferences &references = i->second;
+        Processes &writers            = processesMap[decl];
+        for (ProcessReferences::iterator j = references.begin(); j != references.end(); ++j) {
+            StateTable *process = j->process;
             // Skip processes that both write and read: this should become
             // a local variable!
-            if (processesMap[decl].find(process) != processesMap[decl].end())
+            if (writers.find(process) != writers.end())
                 continue;
             // Must be read
-            const bool isTarget = hif::manipulation::isInLeftHandSide(symbol);
-            if (isTarget)
+            if (j->isTarget)
                 continue;
             // Check sensitivities!
-            typedef hif::HifTypedQuery<Identifier> Query;
-            Query query;
-            Query::Results results;
-            query.onlyFirstMatch = true;
-            query.name           = decl->getName();
-            hif::search(results, process->sensitivity, query);
-            hif::search(results, process->sensitivityPos, query);
-            hif::search(results, process->sensitivityNeg, query);
-            if (!results.empty())
-                continue;
+            if (checkLevel == ndc_full) {
+                if (_isInSensitivity(process, decl))
+                    continue;
+            } else {
+                const SensitivityNames &names = _getSensitivityNames(process, sensitivityIndex);
+                if (names.find(decl->getName()) != names.end())
+                    continue;
+            }
             warnings.insert(decl);
             break;
         }
@@ -1673,7 +2097,11 @@ void _partialFlattening(
     }
 }
 
-void performStep3Refinements(hif::System *o, hif::semantics::ILanguageSemantics *sem, const bool preserveStructure)
+void performStep3Refinements(
+    hif::System *o,
+    hif::semantics::ILanguageSemantics *sem,
+    const bool preserveStructure,
+    const NonDeterminismCheck nonDeterminismCheck)
 {
     // ///////////////////////////////////////////////////////////////////
     // Ensuring no concats as targets.
@@ -1701,7 +2129,7 @@ void performStep3Refinements(hif::System *o, hif::semantics::ILanguageSemantics
     // ///////////////////////////////////////////////////////////////////
     // Prerefine checks
     // ///////////////////////////////////////////////////////////////////
-    _performOriginalDesignChecks(refMap, sem);
+    _performOriginalDesignChecks(refMap, sem, nonDeterminismCheck);
 
     // ///////////////////////////////////////////////////////////////////
     // Heuristic to avoid loops in logic cones.
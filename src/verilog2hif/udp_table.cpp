@@ -0,0 +1,315 @@
+/// @file udp_table.cpp
+/// @brief
+/// @copyright (c) 2024 Electronic Systems Design (ESD) Lab @ UniVR
+/// This file is distributed under the BSD 2-Clause License.
+/// See LICENSE.md for details.
+
+#include "verilog2hif/udp_table.hpp"
+
+namespace
+{
+
+const unsigned char _allValues = (1 << UdpTable::CODE_ZERO) | (1 << UdpTable::CODE_ONE) | (1 << UdpTable::CODE_X);
+
+const char _codeSymbols[] = {'0', '1', 'X'};
+
+} // namespace
+
+UdpTable::Column::Column()
+    : previous(0)
+    , current(0)
+    , isEdge(false)
+{
+    // ntd
+}
+
+UdpTable::Column::~Column()
+{
+    // ntd
+}
+
+UdpTable::Entry::Entry()
+    : inputs()
+    , edge(0)
+    , state(_allValues)
+    , output('\0')
+{
+    // ntd
+}
+
+UdpTable::Entry::~Entry()
+{
+    // ntd
+}
+
+UdpTable::UdpTable(const std::size_t inputs, const bool sequential)
+    : _inputs(inputs)
+    , _sequential(sequential)
+    , _entries()
+{
+    // ntd
+}
+
+UdpTable::~UdpTable()
+{
+    // ntd
+}
+
+std::string UdpTable::addEntry(const std::string &inputs, const char state, const char output)
+{
+    Entry entry;
+    entry.edge = _inputs;
+
+    for (std::string::size_type i = 0; i < inputs.size(); ++i) {
+        Column column;
+        if (inputs[i] == '(') {
+            // Explicit edge: (ab)
+            if (i + 3 >= inputs.size() || inputs[i + 3] != ')')
+                return "Malformed edge in UDP table entry";
+            column.previous = _getLevelMask(inputs[i + 1]);
+            column.current  = _getLevelMask(inputs[i + 2]);
+            column.isEdge   = true;
+            if (column.previous == 0 || column.current == 0)
+                return "Unexpected symbol in UDP table edge";
+            i += 3;
+        } else {
+            column.current = _getLevelMask(inputs[i]);
+            if (column.current == 0) {
+                if (!_getEdgeMasks(inputs[i], column.previous, column.current))
+                    return std::string("Unexpected symbol '") + inputs[i] + "' in UDP table entry";
+                column.isEdge = true;
+            }
+        }
+
+        if (column.isEdge) {
+            if (!_sequential)
+                return "Edges are allowed only in sequential UDP table entries";
+            if (entry.edge != _inputs)
+                return "At most one edge is allowed per UDP table entry";
+            entry.edge = entry.inputs.size();
+        }
+
+        entry.inputs.push_back(column);
+    }
+
+    if (entry.inputs.size() != _inputs)
+        return "UDP table entry does not match the number of inputs";
+
+    if (_sequential) {
+        if (state == '\0')
+            return "Missing current state in sequential UDP table entry";
+        entry.state = _getLevelMask(state);
+        if (entry.state == 0)
+            return std::string("Unexpected current state '") + state + "' in UDP table entry";
+    } else if (state != '\0') {
+        return "Unexpected current state in combinational UDP table entry";
+    }
+
+    if (output != '0' && output != '1' && output != 'x' && output != 'X' && (output != '-' || !_sequential))
+        return std::string("Unexpected output '") + output + "' in UDP table entry";
+    entry.output = output;
+
+    _entries.push_back(entry);
+    return "";
+}
+
+unsigned long long UdpTable::getSize() const
+{
+    if (!_sequential)
+        return getWeight(_inputs);
+
+    // Changed input, its previous value, the inputs and the state.
+    return _inputs * getWeight(_inputs + 2);
+}
+
+std::string UdpTable::compile() const
+{
+    const unsigned long long size = getSize();
+    std::string table(size, 'X');
+
+    Pattern inputs(_inputs, CODE_ZERO);
+    for (unsigned long long index = 0; index < size; ++index) {
+        unsigned long long rest = index;
+        unsigned int state      = CODE_X;
+        if (_sequential) {
+            state = static_cast<unsigned int>(rest % CODES);
+            rest /= CODES;
+        }
+        for (std::size_t i = 0; i < _inputs; ++i) {
+            inputs[i] = static_cast<unsigned int>(rest % CODES);
+            rest /= CODES;
+        }
+
+        if (!_sequential) {
+            const char output = _match(_inputs, CODE_ZERO, inputs, state);
+            if (output != '\0')
+                table[index] = _getTableSymbol(output, state);
+            continue;
+        }
+
+        const unsigned int previous = static_cast<unsigned int>(rest % CODES);
+        const std::size_t changed   = static_cast<std::size_t>(rest / CODES);
+        if (previous == inputs[changed]) {
+            // Not an input change: never looked up, keep the state.
+            table[index] = _codeSymbols[state];
+            continue;
+        }
+
+        char output = _match(_inputs, previous, inputs, state);
+        if (output == '\0')
+            output = _match(changed, previous, inputs, state);
+        if (output != '\0')
+            table[index] = _getTableSymbol(output, state);
+    }
+
+    return table;
+}
+
+unsigned long long UdpTable::getWeight(const std::size_t exponent)
+{
+    unsigned long long ret = 1;
+    for (std::size_t i = 0; i < exponent; ++i)
+        ret *= CODES;
+    return ret;
+}
+
+unsigned char UdpTable::_getLevelMask(const char symbol)
+{
+    switch (symbol) {
+    case '0':
+        return 1 << CODE_ZERO;
+    case '1':
+        return 1 << CODE_ONE;
+    case 'x':
+    case 'X':
+        return 1 << CODE_X;
+    case 'b':
+        return (1 << CODE_ZERO) | (1 << CODE_ONE);
+    case '?':
+        return _allValues;
+    default:
+        return 0;
+    }
+}
+
+bool UdpTable::_getEdgeMasks(const char symbol, unsigned char &previous, unsigned char &current)
+{
+    const unsigned char zero = 1 << CODE_ZERO;
+    const unsigned char one  = 1 << CODE_ONE;
+    const unsigned char x    = 1 << CODE_X;
+
+    // See the UDP table rules of the lexer for the symbols of the
+    // parenthesized edges.
+    switch (symbol) {
+    case 'r': // (01)
+        previous = zero;
+        current  = one;
+        break;
+    case 'f': // (10)
+        previous = one;
+        current  = zero;
+        break;
+    case 'p': // (01), (0x), (x1)
+        previous = zero | x;
+        current  = one | x;
+        break;
+    case 'n': // (10), (1x), (x0)
+        previous = one | x;
+        current  = zero | x;
+        break;
+    case '*': // (??)
+        previous = _allValues;
+        current  = _allValues;
+        break;
+    case '_': // (?0)
+        previous = _allValues;
+        current  = zero;
+        break;
+    case '+': // (?1)
+        previous = _allValues;
+        current  = one;
+        break;
+    case '%': // (?x)
+        previous = _allValues;
+        current  = x;
+        break;
+    case 'Q': // (0x)
+        previous = zero;
+        current  = x;
+        break;
+    case 'q': // (bx)
+        previous = zero | one;
+        current  = x;
+        break;
+    case 'P': // (0?)
+        previous = zero;
+        current  = _allValues;
+        break;
+    case 'M': // (1x)
+        previous = one;
+        current  = x;
+        break;
+    case 'N': // (1?)
+        previous = one;
+        current  = _allValues;
+        break;
+    case 'F': // (x0)
+        previous = x;
+        current  = zero;
+        break;
+    case 'R': // (x1)
+        previous = x;
+        current  = one;
+        break;
+    case 'B': // (x?)
+        previous = x;
+        current  = _allValues;
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+char UdpTable::_match(
+    const std::size_t changed,
+    const unsigned int previous,
+    const Pattern &inputs,
+    const unsigned int state) const
+{
+    for (std::vector<Entry>::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+        const Entry &entry = *i;
+        if (entry.edge != changed)
+            continue;
+        if (_sequential && (entry.state & (1 << state)) == 0)
+            continue;
+
+        bool matches = true;
+        for (std::size_t j = 0; matches && j < _inputs; ++j) {
+            const Column &column = entry.inputs[j];
+            matches              = (column.current & (1 << inputs[j])) != 0;
+            if (column.isEdge)
+                matches = matches && (column.previous & (1 << previous)) != 0;
+        }
+
+        if (matches)
+            return entry.output;
+    }
+
+    return '\0';
+}
+
+char UdpTable::_getTableSymbol(const char output, const unsigned int state)
+{
+    switch (output) {
+    case '0':
+        return '0';
+    case '1':
+        return '1';
+    case '-':
+        return _codeSymbols[state];
+    default:
+        return 'X';
+    }
+}
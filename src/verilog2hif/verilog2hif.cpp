@@ -12,6 +12,7 @@
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 /////////////////////////////////////////
@@ -28,6 +29,7 @@
 /////////////////////////////////////////
 // Tool includes
 /////////////////////////////////////////
+#include "common/stage_checkpoints.hpp"
 #include "verilog2hif/parse_line.hpp"
 #include "verilog2hif/post_parsing_methods.hpp"
 #include "verilog2hif/support.hpp"
@@ -78,6 +80,28 @@ namespace
 
 hif::application_utils::StepFileManager _stepFileManager;
 
+/// @brief The stages after which a checkpoint can be written, in execution order.
+const char *const _stages[] = {
+    "parsing", "step1", "step2", "rename", "bindOpenPorts", "step3", "standardization", "ams"};
+const int _stagesNumber = static_cast<int>(sizeof(_stages) / sizeof(_stages[0]));
+
+StageCheckpoints _checkpoints(_stages, _stagesNumber, "CHECKPOINT_VAMS_STANDARD");
+
+/// @brief Returns true if some design unit has been recorded with instances
+/// having open or missing port connections, clearing the records.
+bool _takeOpenPortsRecords(System *systOb)
+{
+    bool ret = systOb->checkProperty(PROPERTY_OPEN_PORTS);
+    systOb->removeProperty(PROPERTY_OPEN_PORTS);
+    for (BList<DesignUnit>::iterator i = systOb->designUnits.begin(); i != systOb->designUnits.end(); ++i) {
+        if (!(*i)->checkProperty(PROPERTY_OPEN_PORTS))
+            continue;
+        (*i)->removeProperty(PROPERTY_OPEN_PORTS);
+        ret = true;
+    }
+    return ret;
+}
+
 } // namespace
 
 /////////////////////////////////////////
@@ -102,42 +126,52 @@ int main(int argc, char *argv[])
     hif::application_utils::setVerboseLog(cLine.isVerbose());
     if (cLine.isWriteParsing()) {
         delete debugStream;
-        debugStream = errorStream;
+        debugStream    = errorStream;
+        yytraceEnabled = true;
     }
 
     // Retrieve output file
     outputFile = cLine.getOutputFile();
 
-    // Retrieve input files list (Verilog)
-    inputFiles = cLine.getFiles();
-    for (Verilog2hifParseLine::Files::iterator it = inputFiles.begin(); it != inputFiles.end(); ++it) {
-        VerilogParser parser(*it, cLine);
-        if (!parser.parse(cLine.isParseOnly())) {
-            std::string msg("Cannot parse file '");
-            msg = msg.append(*it);
-            msg = msg.append("'");
-            messageError(msg, nullptr, nullptr);
-        }
-    }
+    const std::string checkpointStage = cLine.getCheckpointStage();
+    if (!checkpointStage.empty())
+        _checkpoints.setCheckpointStage(checkpointStage, outputFile);
 
-    // Retrieve input files list (VerilogA)
-    inputFiles = cLine.getAmsFiles();
-    VerilogParser::setVerilogAms(true);
+    System *systOb        = nullptr;
     bool needVAMSStandard = false;
-    for (Verilog2hifParseLine::Files::iterator it = inputFiles.begin(); it != inputFiles.end(); ++it) {
-        VerilogParser parser(*it, cLine);
-
-        if (!parser.parse(cLine.isParseOnly())) {
-            std::string msg("Cannot parse file '");
-            msg = msg.append(*it);
-            msg = msg.append("'");
-            messageError(msg, nullptr, nullptr);
+    if (!cLine.getResumeFile().empty()) {
+        systOb = _checkpoints.resume(cLine.getResumeFile(), needVAMSStandard);
+    } else {
+        // Retrieve input files list (Verilog)
+        inputFiles = cLine.getFiles();
+        for (Verilog2hifParseLine::Files::iterator it = inputFiles.begin(); it != inputFiles.end(); ++it) {
+            VerilogParser parser(*it, cLine);
+            if (!parser.parse(cLine.isParseOnly())) {
+                std::string msg("Cannot parse file '");
+                msg = msg.append(*it);
+                msg = msg.append("'");
+                messageError(msg, nullptr, nullptr);
+            }
         }
 
-        needVAMSStandard = true;
-    }
+        // Retrieve input files list (VerilogA)
+        inputFiles = cLine.getAmsFiles();
+        VerilogParser::setVerilogAms(true);
+        for (Verilog2hifParseLine::Files::iterator it = inputFiles.begin(); it != inputFiles.end(); ++it) {
+            VerilogParser parser(*it, cLine);
+
+            if (!parser.parse(cLine.isParseOnly())) {
+                std::string msg("Cannot parse file '");
+                msg = msg.append(*it);
+                msg = msg.append("'");
+                messageError(msg, nullptr, nullptr);
+            }
 
-    System *systOb = VerilogParser::buildSystemObject();
+            needVAMSStandard = true;
+        }
+
+        systOb = VerilogParser::buildSystemObject();
+    }
 
     if (cLine.isParseOnly() || cLine.isPrintOnly()) {
         hif::writeFile(outputFile.c_str(), systOb, true);
@@ -156,6 +190,7 @@ int main(int argc, char *argv[])
     }
 
     _stepFileManager.printStep(systOb, "parsing_result");
+    _checkpoints.checkpoint(systOb, "parsing", needVAMSStandard);
 
     auto *verilogLanguage = hif::semantics::VerilogSemantics::getInstance();
     auto *hifLanguage     = hif::semantics::HIFSemantics::getInstance();
@@ -164,16 +199,22 @@ int main(int argc, char *argv[])
     postParsingRefinements(systOb, verilogLanguage, needVAMSStandard, cLine);
 
     // Standardize description.
-    messageInfo("Performing standardization");
-    _stepFileManager.startStep("STD");
-    standardizeDescription(systOb, verilogLanguage, hifLanguage, &_stepFileManager);
-    _stepFileManager.endStep(systOb);
+    if (_checkpoints.mustRun("standardization")) {
+        messageInfo("Performing standardization");
+        _stepFileManager.startStep("STD");
+        standardizeDescription(systOb, verilogLanguage, hifLanguage, &_stepFileManager);
+        _stepFileManager.endStep(systOb);
+        _checkpoints.checkpoint(systOb, "standardization", needVAMSStandard);
+    }
 
     // Marking AMS.
-    messageInfo("Refining possible AMS units");
-    if (needVAMSStandard)
-        markAmsLanguage(systOb, hifLanguage);
-    _stepFileManager.printStep(systOb, "markAmsLanguage");
+    if (_checkpoints.mustRun("ams")) {
+        messageInfo("Refining possible AMS units");
+        if (needVAMSStandard)
+            markAmsLanguage(systOb, hifLanguage);
+        _stepFileManager.printStep(systOb, "markAmsLanguage");
+        _checkpoints.checkpoint(systOb, "ams", needVAMSStandard);
+    }
 
     // Finally, check description
     messageInfo("Performing HIF description sanity checks");
@@ -226,41 +267,59 @@ void postParsingRefinements(
     const bool needVAMSStandard,
     Verilog2hifParseLine &cLine)
 {
-    // Add Verilog standard package
-    if (needVAMSStandard) {
-        systOb->libraryDefs.push_back(sem->getStandardLibrary("vams_standard"));
-
-        // The following code is a workaround until the inclusion issue will be fixed in lexer
-        systOb->libraryDefs.push_back(sem->getStandardLibrary("vams_constants"));
-        systOb->libraryDefs.push_back(sem->getStandardLibrary("vams_disciplines"));
-        systOb->libraryDefs.push_back(sem->getStandardLibrary("vams_driver_access"));
-        hif::HifFactory f(sem);
-        systOb->libraries.push_back(f.library("vams_standard", nullptr, "", false, true));
-        systOb->libraries.push_back(f.library("vams_constants", nullptr, "", false, true));
-        systOb->libraries.push_back(f.library("vams_disciplines", nullptr, "", false, true));
-        systOb->libraries.push_back(f.library("vams_driver_access", nullptr, "", false, true));
-    }
-    sem->addStandardPackages(systOb);
-    _stepFileManager.printStep(systOb, "standardPackagesRefines");
+    if (_checkpoints.mustRun("step1")) {
+        // Add Verilog standard package
+        if (needVAMSStandard) {
+            systOb->libraryDefs.push_back(sem->getStandardLibrary("vams_standard"));
+
+            // The following code is a workaround until the inclusion issue will be fixed in lexer
+            systOb->libraryDefs.push_back(sem->getStandardLibrary("vams_constants"));
+            systOb->libraryDefs.push_back(sem->getStandardLibrary("vams_disciplines"));
+            systOb->libraryDefs.push_back(sem->getStandardLibrary("vams_driver_access"));
+            hif::HifFactory f(sem);
+            systOb->libraries.push_back(f.library("vams_standard", nullptr, "", false, true));
+            systOb->libraries.push_back(f.library("vams_constants", nullptr, "", false, true));
+            systOb->libraries.push_back(f.library("vams_disciplines", nullptr, "", false, true));
+            systOb->libraries.push_back(f.library("vams_driver_access", nullptr, "", false, true));
+        }
+        sem->addStandardPackages(systOb);
+        _stepFileManager.printStep(systOb, "standardPackagesRefines");
 
-    messageInfo("Performing post-parsing refinements - step 1");
-    performStep1Refinements(systOb, sem);
-    _stepFileManager.printStep(systOb, "performStep1Refinements");
+        messageInfo("Performing post-parsing refinements - step 1");
+        performStep1Refinements(systOb, sem);
+        _stepFileManager.printStep(systOb, "performStep1Refinements");
+        _checkpoints.checkpoint(systOb, "step1", needVAMSStandard);
+    }
 
-    messageInfo("Performing post-parsing refinements - step 2");
-    performStep2Refinements(systOb, sem);
-    _stepFileManager.printStep(systOb, "performStep2Refinements");
+    if (_checkpoints.mustRun("step2")) {
+        messageInfo("Performing post-parsing refinements - step 2");
+        performStep2Refinements(systOb, sem);
+        _stepFileManager.printStep(systOb, "performStep2Refinements");
+        _checkpoints.checkpoint(systOb, "step2", needVAMSStandard);
+    }
 
-    messageInfo("Renaming conflicting declarations");
-    hif::manipulation::renameConflictingDeclarations(systOb, sem, nullptr, "inst");
-    _stepFileManager.printStep(systOb, "renameConflictingDeclarations");
+    if (_checkpoints.mustRun("rename")) {
+        messageInfo("Renaming conflicting declarations");
+        hif::manipulation::renameConflictingDeclarations(systOb, sem, nullptr, "inst");
+        _stepFileManager.printStep(systOb, "renameConflictingDeclarations");
+        _checkpoints.checkpoint(systOb, "rename", needVAMSStandard);
+    }
 
     // Bind open port assigns.
-    messageInfo("Binding open ports (if any)");
-    hif::manipulation::bindOpenPortAssigns(*systOb, sem);
-    _stepFileManager.printStep(systOb, "bindOpenPortAssigns");
+    if (_checkpoints.mustRun("bindOpenPorts")) {
+        // Instances with open ports have been recorded by step 1.
+        if (_takeOpenPortsRecords(systOb)) {
+            messageInfo("Binding open ports");
+            hif::manipulation::bindOpenPortAssigns(*systOb, sem);
+        }
+        _stepFileManager.printStep(systOb, "bindOpenPortAssigns");
+        _checkpoints.checkpoint(systOb, "bindOpenPorts", needVAMSStandard);
+    }
 
-    messageInfo("Performing post-parsing refinements - step 3");
-    performStep3Refinements(systOb, sem, cLine.getStructure());
-    _stepFileManager.printStep(systOb, "performStep3Refinements");
+    if (_checkpoints.mustRun("step3")) {
+        messageInfo("Performing post-parsing refinements - step 3");
+        performStep3Refinements(systOb, sem, cLine.getStructure(), cLine.getNonDeterminismCheck());
+        _stepFileManager.printStep(systOb, "performStep3Refinements");
+        _checkpoints.checkpoint(systOb, "step3", needVAMSStandard);
+    }
 }
@@ -47,6 +47,18 @@ Verilog2hifParseLine::Verilog2hifParseLine(int argc, char *argv[])
         's', "structure", false, true,
         "Preserve design structure even when this could lead to "
         "non-equivalent translation.");
+    addOption(
+        'n', "nondeterminism-check", true, true,
+        "Level of the check for signals written by blocking assignments and "
+        "read outside the sensitivity of a process: off, fast (default) or full.");
+    addOption(
+        'k', "checkpoint-after", true, true,
+        "Write a checkpoint of the translation after the given stage: parsing, "
+        "step1, step2, rename, bindOpenPorts, step3, standardization or ams.");
+    addOption(
+        'r', "resume-from", true, true,
+        "Resume the translation from a checkpoint file, skipping the stages "
+        "it has been written after. No input files are needed.");
 
     parse(argc, argv);
 
@@ -62,6 +74,20 @@ bool Verilog2hifParseLine::getTernary() const { return isOptionFlagSet('t'); }
 
 bool Verilog2hifParseLine::getStructure() const { return isOptionFlagSet('s'); }
 
+NonDeterminismCheck Verilog2hifParseLine::getNonDeterminismCheck()
+{
+    const std::string level = getOption('n');
+    if (level == "off")
+        return ndc_off;
+    if (level == "full")
+        return ndc_full;
+    return ndc_fast;
+}
+
+std::string Verilog2hifParseLine::getCheckpointStage() { return getOption('k'); }
+
+std::string Verilog2hifParseLine::getResumeFile() { return getOption('r'); }
+
 void Verilog2hifParseLine::_validateArguments()
 {
     if (!_options['h'].value.empty())
@@ -69,7 +95,7 @@ void Verilog2hifParseLine::_validateArguments()
     if (!_options['v'].value.empty())
         printVersion();
 
-    if (_files.empty()) {
+    if (_files.empty() && _options['r'].value.empty()) {
         messageError(
             "Verilog input file missing.\n"
             "Try 'verilog2hif --help' for more information",
@@ -90,6 +116,12 @@ void Verilog2hifParseLine::_validateArguments()
         }
     }
 
+    // Validate non-determinism check level
+    const std::string &ndcLevel = _options['n'].value;
+    if (!ndcLevel.empty() && ndcLevel != "off" && ndcLevel != "fast" && ndcLevel != "full") {
+        messageError("Unrecognized non-determinism check level: " + ndcLevel, nullptr, nullptr);
+    }
+
     // Establish output file name
     std::string out = _options['o'].value;
     if (out == "") {
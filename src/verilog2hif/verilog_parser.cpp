@@ -11,9 +11,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
+#include <set>
+#include <vector>
 
+#include "common/fresh_names.hpp"
 #include "verilog2hif/verilog_parser.hpp"
 #include "verilog2hif/support.hpp"
+#include "verilog2hif/udp_table.hpp"
 
 using namespace hif;
 using std::list;
@@ -29,11 +34,42 @@ extern bool init_buffer(const char *fname);
 int yylex_destroy();
 int yyparse(VerilogParser *parser);
 
+namespace
+{
+
+/// @brief Returns the type of one identifier of a declaration list with the
+/// given range. All identifiers but the last one get a copy of the parsed
+/// range, while the last one takes the parsed range itself, which is reset.
+Type *_getDeclarationType(Range *&range, const bool isSigned, const bool last)
+{
+    if (!last || range == nullptr)
+        return getSemanticType(range, isSigned);
+    Bitvector *ret = makeVerilogRegisterType(range);
+    ret->setSigned(isSigned);
+    range = nullptr;
+    return ret;
+}
+
+/// @brief Returns the explicit type of one identifier of a declaration list.
+/// All identifiers but the last one get a copy, while the last one takes the
+/// parsed type itself, which is reset.
+Type *_getDeclarationType(Type *&type, const bool last)
+{
+    if (!last)
+        return hif::copy(type);
+    Type *ret = type;
+    type      = nullptr;
+    return ret;
+}
+
+} // namespace
+
 VerilogParser::VerilogParser(string fileName, const Verilog2hifParseLine &cLine)
     : _fileName(fileName)
     , _tmpCustomLineNumber(0)
     , _tmpCustomColumnNumber(0)
     , _parseOnly(false)
+    , _openPortConnection(false)
     , _unit(nullptr)
     , _precision(nullptr)
     , _sem(hif::semantics::VerilogSemantics::getInstance())
@@ -49,6 +85,7 @@ VerilogParser::~VerilogParser()
     delete _precision;
     _unit      = nullptr;
     _precision = nullptr;
+    _operatorChains.clear();
 }
 
 bool VerilogParser::parse(bool parseOnly)
@@ -229,22 +266,23 @@ void VerilogParser::parse_ModuleDeclaration(
 
     interface_o->ports.merge(*list_of_ports);
     if (referencePortList) {
+        // Ports by name: with duplicated names, the first port gets the merge.
+        typedef std::map<std::string, Port *> PortsByName;
+        PortsByName portsByName;
+        for (BList<Port>::iterator j = interface_o->ports.begin(); j != interface_o->ports.end(); ++j)
+            portsByName.insert(std::make_pair((*j)->getName(), *j));
+
         // Remove declarations with the same name of a port
         BList<Declaration> *decl_list = &contents_o->declarations;
         for (BList<Declaration>::iterator it = decl_list->begin(); it != decl_list->end();) {
-            Port *found = nullptr;
-            for (BList<Port>::iterator j = interface_o->ports.begin(); j != interface_o->ports.end(); ++j) {
-                if ((*it)->getName() == (*j)->getName()) {
-                    found = *j;
-                    break;
-                }
-            }
-
-            if (found == nullptr) {
+            PortsByName::iterator portIt = portsByName.find((*it)->getName());
+            if (portIt == portsByName.end()) {
                 ++it;
                 continue;
             }
 
+            Port *found = portIt->second;
+
             Port *port_o = dynamic_cast<Port *>(*it);
             if (port_o == nullptr) {
                 // declaration with same name: in verilog it still is a port!!
@@ -285,6 +323,7 @@ void VerilogParser::parse_ModuleDeclaration(
 
             it = it.remove();
             found->replace(port_o);
+            portIt->second = port_o;
             delete found;
         }
     }
@@ -378,6 +417,198 @@ void VerilogParser::parse_ModuleDeclaration(
     _designUnits->push_back(du);
 }
 
+void VerilogParser::parse_UdpDeclaration(
+    char *identifier,
+    BList<Identifier> *udp_port_list,
+    BList<Declaration> *udp_port_declaration_list,
+    udp_body_t *udp_body)
+{
+    // Sort the declared ports as in the port list.
+    // A reg declaration makes the output sequential.
+    std::map<std::string, Port *> declaredPorts;
+    std::set<std::string> regs;
+    for (BList<Declaration>::iterator i = udp_port_declaration_list->begin();
+         i != udp_port_declaration_list->end();) {
+        Port *port_o = dynamic_cast<Port *>(*i);
+        if (port_o == nullptr) {
+            regs.insert((*i)->getName());
+            i = i.erase();
+            continue;
+        }
+
+        messageAssert(
+            declaredPorts.insert(std::make_pair(port_o->getName(), port_o)).second, "Duplicated UDP port declaration",
+            port_o, _sem);
+        i = i.remove();
+    }
+
+    BList<Port> *ports = new BList<Port>();
+    for (BList<Identifier>::iterator i = udp_port_list->begin(); i != udp_port_list->end(); ++i) {
+        std::map<std::string, Port *>::iterator found = declaredPorts.find((*i)->getName());
+        messageAssert(found != declaredPorts.end(), "Undeclared UDP port", *i, _sem);
+        ports->push_back(found->second);
+        declaredPorts.erase(found);
+    }
+    messageAssert(declaredPorts.empty(), "Declared port missing in the UDP port list", nullptr, _sem);
+
+    if (!ports->empty() && regs.find(ports->front()->getName()) != regs.end() && ports->front()->getValue() == nullptr)
+        ports->front()->addProperty(IS_VARIABLE_TYPE);
+
+    delete udp_port_list;
+    delete udp_port_declaration_list;
+
+    parse_UdpDeclaration(identifier, ports, udp_body);
+}
+
+void VerilogParser::parse_UdpDeclaration(char *identifier, BList<Port> *udp_declaration_port_list, udp_body_t *udp_body)
+{
+    DesignUnit *du       = parse_ModuleDeclarationStart(identifier);
+    View *view_o         = du->views.back();
+    Contents *contents_o = view_o->getContents();
+
+    messageAssert(
+        udp_declaration_port_list->size() > 1 && udp_declaration_port_list->front()->getDirection() == dir_out,
+        "Expected UDP output followed by inputs", du, _sem);
+    Port *output          = udp_declaration_port_list->front();
+    const bool sequential = output->checkProperty(IS_VARIABLE_TYPE) || output->getValue() != nullptr;
+
+    std::vector<std::string> inputs;
+    for (BList<Port>::iterator i = ++udp_declaration_port_list->begin(); i != udp_declaration_port_list->end(); ++i) {
+        messageAssert((*i)->getDirection() == dir_in, "Expected UDP input", *i, _sem);
+        inputs.push_back((*i)->getName());
+    }
+    const std::size_t inputCount = inputs.size();
+    if (inputCount > (sequential ? 9U : 10U))
+        messageError("Too many inputs for a UDP", du, _sem);
+
+    if (udp_body->initial_statement != nullptr) {
+        Assign *init           = udp_body->initial_statement;
+        Identifier *initTarget = dynamic_cast<Identifier *>(init->getLeftHandSide());
+        messageAssert(
+            sequential && initTarget != nullptr && initTarget->getName() == output->getName(),
+            "Expected initialization of the output of a sequential UDP", init, _sem);
+        delete output->setValue(init->setRightHandSide(nullptr));
+        delete init;
+    }
+    // As for output declarations, an initialized output is not a variable.
+    if (output->getValue() != nullptr)
+        output->removeProperty(IS_VARIABLE_TYPE);
+    else if (sequential && !output->checkProperty(IS_VARIABLE_TYPE))
+        output->addProperty(IS_VARIABLE_TYPE);
+
+    // The ports are added first, so that the generated names cannot clash with them.
+    view_o->getEntity()->ports.merge(*udp_declaration_port_list);
+    delete udp_declaration_port_list;
+    FreshNames freshNames;
+
+    UdpTable table(inputCount, sequential);
+    for (std::list<udp_entry_t *>::iterator i = udp_body->entries->begin(); i != udp_body->entries->end(); ++i) {
+        const std::string error = table.addEntry((*i)->inputs, (*i)->state, (*i)->output);
+        if (!error.empty())
+            messageError(error, du, _sem);
+        delete *i;
+    }
+    delete udp_body->entries;
+    delete udp_body;
+
+    // The lookup table is a constant bit vector, whose bit 0 is the last one.
+    std::string lookup = table.compile();
+    std::reverse(lookup.begin(), lookup.end());
+
+    Const *table_o = new Const();
+    setCodeInfoFromCurrentBlock(table_o);
+    table_o->setName(freshNames.get(view_o, "udp_table"));
+    table_o->setType(makeVerilogRegisterType(new Range(static_cast<long long>(lookup.size()) - 1, 0)));
+    table_o->setValue(new BitvectorValue(lookup));
+    contents_o->declarations.push_back(table_o);
+
+    if (!sequential) {
+        // output = table[sum(code(input_i) * 3^i)]
+        Value *index = nullptr;
+        for (std::size_t i = 0; i < inputCount; ++i) {
+            Value *term = parse_ExpressionBinaryOperator(
+                _makeUdpCode(new Identifier(inputs[i])), op_mult,
+                _factory.intval(static_cast<long long>(UdpTable::getWeight(i))));
+            index = (index == nullptr) ? term : parse_ExpressionBinaryOperator(index, op_plus, term);
+        }
+
+        contents_o->getGlobalAction()->actions.push_back(
+            parse_Assignment(new Identifier(output->getName()), _makeUdpLookup(table_o->getName(), index)));
+    } else {
+        // A process evaluates the table once per changed input, in order,
+        // and keeps the previous value of each input.
+        StateTable *stateTable_o = new StateTable();
+        setCodeInfoFromCurrentBlock(stateTable_o);
+        stateTable_o->setName(freshNames.get(view_o, "udp_process"));
+        stateTable_o->setDontInitialize(false);
+
+        State *state_o = new State();
+        setCodeInfoFromCurrentBlock(state_o);
+        state_o->setName(stateTable_o->getName());
+        stateTable_o->states.push_back(state_o);
+
+        Variable *next = new Variable();
+        setCodeInfoFromCurrentBlock(next);
+        next->setName(freshNames.get(view_o, "udp_state"));
+        next->setType(makeVerilogBitType());
+        stateTable_o->declarations.push_back(next);
+        state_o->actions.push_back(
+            parse_Assignment(new Identifier(next->getName()), new Identifier(output->getName())));
+
+        std::vector<std::string> previous;
+        for (std::size_t i = 0; i < inputCount; ++i) {
+            Signal *prev = new Signal();
+            setCodeInfoFromCurrentBlock(prev);
+            prev->addProperty(IS_VARIABLE_TYPE);
+            prev->setName(freshNames.get(view_o, inputs[i], "_udp_previous"));
+            prev->setType(makeVerilogBitType());
+            contents_o->declarations.push_back(prev);
+            previous.push_back(prev->getName());
+            stateTable_o->sensitivity.push_back(new Identifier(inputs[i]));
+        }
+
+        for (std::size_t j = 0; j < inputCount; ++j) {
+            // Inputs before j have already been evaluated with their current value.
+            Value *index = _factory.intval(static_cast<long long>(j * UdpTable::getWeight(inputCount + 2)));
+            index        = parse_ExpressionBinaryOperator(
+                index, op_plus,
+                parse_ExpressionBinaryOperator(
+                    _makeUdpCode(new Identifier(previous[j])), op_mult,
+                    _factory.intval(static_cast<long long>(UdpTable::getWeight(inputCount + 1)))));
+            for (std::size_t i = 0; i < inputCount; ++i) {
+                Value *input = new Identifier(i <= j ? inputs[i] : previous[i]);
+                index        = parse_ExpressionBinaryOperator(
+                    index, op_plus,
+                    parse_ExpressionBinaryOperator(
+                        _makeUdpCode(input), op_mult,
+                        _factory.intval(static_cast<long long>(UdpTable::getWeight(i + 1)))));
+            }
+            index = parse_ExpressionBinaryOperator(index, op_plus, _makeUdpCode(new Identifier(next->getName())));
+
+            IfAlt *ifAlt_o = new IfAlt();
+            setCodeInfoFromCurrentBlock(ifAlt_o);
+            ifAlt_o->setCondition(parse_ExpressionBinaryOperator(
+                new Identifier(inputs[j]), op_case_neq, new Identifier(previous[j])));
+            ifAlt_o->actions.push_back(
+                parse_Assignment(new Identifier(next->getName()), _makeUdpLookup(table_o->getName(), index)));
+
+            If *if_o = new If();
+            setCodeInfoFromCurrentBlock(if_o);
+            if_o->alts.push_back(ifAlt_o);
+            state_o->actions.push_back(if_o);
+        }
+
+        for (std::size_t i = 0; i < inputCount; ++i)
+            state_o->actions.push_back(parse_Assignment(new Identifier(previous[i]), new Identifier(inputs[i])));
+        state_o->actions.push_back(
+            parse_Assignment(new Identifier(output->getName()), new Identifier(next->getName())));
+
+        contents_o->stateTables.push_back(stateTable_o);
+    }
+
+    _designUnits->push_back(du);
+}
+
 Assign *VerilogParser::parse_AnalogVariableAssignment(Value *lvalue, Value *expression)
 {
     Assign *ret = new Assign();
@@ -444,7 +675,7 @@ StateTable *VerilogParser::parse_AlwaysConstruct(statement_t *statement)
             statement->procedural_timing_control->event_control, stateTable_o->sensitivity, allSignals);
 
         if (allSignals) {
-            stateTable_o->addProperty("ALL_SIGNALS");
+            stateTable_o->addProperty(PROPERTY_ALL_SIGNALS);
         }
 
         delete statement->procedural_timing_control->event_control;
@@ -547,6 +778,105 @@ BList<Assign> *VerilogParser::parse_ContinuousAssign(Value *delay3_opt, BList<As
     return list_of_net_assignments;
 }
 
+BList<Assign> *VerilogParser::parse_GateInstantiation(
+    gate_type_t gate_type,
+    Value *delay,
+    std::list<BList<Value> *> *gate_instance_list)
+{
+    BList<Assign> *ret = new BList<Assign>();
+
+    for (std::list<BList<Value> *>::iterator i = gate_instance_list->begin(); i != gate_instance_list->end(); ++i) {
+        std::vector<Value *> terminals((*i)->begin(), (*i)->end());
+        (*i)->removeAll();
+        delete *i;
+
+        switch (gate_type) {
+        case gate_and:
+        case gate_nand:
+        case gate_or:
+        case gate_nor:
+        case gate_xor:
+        case gate_xnor: {
+            // (out, in1, in2, ...): out = in1 op in2 op ...
+            Operator op = op_band;
+            if (gate_type == gate_or || gate_type == gate_nor)
+                op = op_bor;
+            else if (gate_type == gate_xor || gate_type == gate_xnor)
+                op = op_bxor;
+
+            Value *expr = terminals[1];
+            for (std::vector<Value *>::size_type j = 2; j < terminals.size(); ++j)
+                expr = parse_ExpressionBinaryOperator(expr, op, terminals[j]);
+
+            if (gate_type == gate_nand || gate_type == gate_nor || gate_type == gate_xnor) {
+                expr = new Expression(op_bnot, expr);
+                setCodeInfo(expr);
+            }
+
+            ret->push_back(parse_Assignment(terminals.front(), expr));
+            break;
+        }
+        case gate_buf:
+        case gate_not: {
+            // (out1, out2, ..., in): outN = in
+            // A z input drives x on buf outputs: outN = in === 'z ? 'x : in
+            Value *input = terminals.back();
+            terminals.pop_back();
+            for (std::vector<Value *>::iterator j = terminals.begin(); j != terminals.end(); ++j) {
+                Value *expr = hif::copy(input);
+                if (gate_type == gate_not) {
+                    expr = new Expression(op_bnot, expr);
+                    setCodeInfo(expr);
+                } else {
+                    BitValue *z = new BitValue();
+                    setCodeInfo(z);
+                    z->setValue(bit_z);
+
+                    BitValue *x = new BitValue();
+                    setCodeInfo(x);
+                    x->setValue(bit_x);
+
+                    Value *isZ = parse_ExpressionBinaryOperator(hif::copy(input), op_case_eq, z);
+                    expr       = parse_ExpressionTernaryOperator(isZ, x, expr);
+                }
+                ret->push_back(parse_Assignment(*j, expr));
+            }
+            delete input;
+            break;
+        }
+        case gate_bufif0:
+        case gate_bufif1:
+        case gate_notif0:
+        case gate_notif1: {
+            // (out, in, enable): out = enable ? in : 'z
+            Value *input = terminals[1];
+            if (gate_type == gate_notif0 || gate_type == gate_notif1) {
+                input = new Expression(op_bnot, input);
+                setCodeInfo(input);
+            }
+
+            BitValue *z = new BitValue();
+            setCodeInfo(z);
+            z->setValue(bit_z);
+
+            Value *expr = nullptr;
+            if (gate_type == gate_bufif1 || gate_type == gate_notif1)
+                expr = parse_ExpressionTernaryOperator(terminals[2], input, z);
+            else
+                expr = parse_ExpressionTernaryOperator(terminals[2], z, input);
+
+            ret->push_back(parse_Assignment(terminals.front(), expr));
+            break;
+        }
+        default:
+            messageError("Unexpected gate type", nullptr, _sem);
+        }
+    }
+
+    delete gate_instance_list;
+    return parse_ContinuousAssign(delay, ret);
+}
+
 Port *VerilogParser::parse_PortReference(char *identifier)
 {
     Port *port_o = new Port();
@@ -847,7 +1177,7 @@ BList<Port> *VerilogParser::parse_OutputDeclaration(
     for (BList<Port>::iterator i = list_of_variable_port_identifiers->begin();
          i != list_of_variable_port_identifiers->end(); ++i) {
         (*i)->setDirection(dir_out);
-        (*i)->setType(getSemanticType(range, k_signed));
+        (*i)->setType(_getDeclarationType(range, k_signed, *i == list_of_variable_port_identifiers->back()));
 
         ConstValue *constValue_o = dynamic_cast<ConstValue *>((*i)->getValue());
         if (constValue_o != nullptr) {
@@ -1122,6 +1452,9 @@ Value *VerilogParser::parse_ExpressionBinaryOperator(
     if (expression1 == nullptr || expression2 == nullptr)
         return nullptr;
 
+    if (!negate && _isChainOperator(binary_op))
+        return _appendToChain(expression1, binary_op, expression2);
+
     Expression *expr = new Expression();
     setCodeInfo(expr);
 
@@ -1437,8 +1770,9 @@ BList<Declaration> *VerilogParser::parse_RegDeclaration(
 
     // set the type of all Declaration of the list
     for (BList<Signal>::iterator i = list_of_variable_identifiers->begin(); i != list_of_variable_identifiers->end();) {
-        Signal *var_o = *i;
-        i             = i.remove();
+        Signal *var_o   = *i;
+        i               = i.remove();
+        const bool last = (i == list_of_variable_identifiers->end());
 
         Array *array_o = dynamic_cast<Array *>(var_o->getType());
 
@@ -1447,18 +1781,18 @@ BList<Declaration> *VerilogParser::parse_RegDeclaration(
 
             // set the type of the array received from register_variable_list
             // as array of bit where range is set as range_opt
-            array_o->setType(getSemanticType(range_opt, K_signed_opt));
+            array_o->setType(_getDeclarationType(range_opt, K_signed_opt, last));
             array_o->setSigned(false);
         } else {
             messageAssert(var_o->getType() == nullptr, "Wrong type", var_o, nullptr);
-            var_o->setType(getSemanticType(range_opt, K_signed_opt));
+            var_o->setType(_getDeclarationType(range_opt, K_signed_opt, last));
         }
 
         res->push_back(var_o);
     }
 
     delete discipline_identifier_signed_range->discipline_identifier;
-    delete discipline_identifier_signed_range->range;
+    delete range_opt;
     delete discipline_identifier_signed_range;
 
     delete list_of_variable_identifiers;
@@ -1527,8 +1861,9 @@ BList<Declaration> *VerilogParser::parse_NetDeclaration(
 
     for (list<net_ams_decl_identifier_assignment_t *>::iterator it = identifiers_or_assign->begin();
          it != identifiers_or_assign->end(); ++it) {
-        curr     = *it;
-        signal_o = new Signal();
+        curr            = *it;
+        const bool last = (curr == identifiers_or_assign->back());
+        signal_o        = new Signal();
         setCodeInfo(signal_o);
 
         hif::TerminalPrefixOptions topt;
@@ -1567,15 +1902,15 @@ BList<Declaration> *VerilogParser::parse_NetDeclaration(
             }
 
             if (explicitType != nullptr)
-                array_prev->setType(hif::copy(explicitType));
+                array_prev->setType(_getDeclarationType(explicitType, last));
             else
-                array_prev->setType(getSemanticType(range));
+                array_prev->setType(_getDeclarationType(range, false, last));
             signal_o->setType(array_prev);
         } else {
             if (explicitType != nullptr)
-                signal_o->setType(hif::copy(explicitType));
+                signal_o->setType(_getDeclarationType(explicitType, last));
             else
-                signal_o->setType(getSemanticType(range, is_signed));
+                signal_o->setType(_getDeclarationType(range, is_signed, last));
         }
 
         signal_list->push_back(signal_o);
@@ -1874,26 +2209,41 @@ VerilogParser::parse_AnalogCaseItem(hif::BList<Value> *expression_list, analog_s
 
 If *VerilogParser::parse_ConditionalStatement(If *ifStatement)
 {
-    if (ifStatement->defaults.size() != 1)
-        return ifStatement;
-
-    // if there is only one default and it is IF object
-    If *act = dynamic_cast<If *>(ifStatement->defaults.front());
-    if (act == nullptr)
-        return ifStatement;
+    // Collect the else-if chain: each IF whose only default is an IF.
+    std::vector<If *> chain;
+    If *tail = ifStatement;
+    while (tail->defaults.size() == 1) {
+        If *act = dynamic_cast<If *>(tail->defaults.front());
+        if (act == nullptr)
+            break;
 
-    // remove the default
-    ifStatement->defaults.remove(act);
+        // remove the default
+        tail->defaults.remove(act);
+        chain.push_back(tail);
+        tail = act;
+    }
 
-    act = parse_ConditionalStatement(act);
+    if (chain.empty())
+        return ifStatement;
 
-    // move the Alts and Defaults from the IF to the parent IF
-    ifStatement->alts.merge(act->alts);
-    ifStatement->defaults.merge(act->defaults);
+    // Nested IFs are flattened as soon as they are reduced, so the tail
+    // usually holds most of the alts: reuse it and move the few alts of the
+    // outer IFs in front of its own, instead of moving the accumulated chain
+    // up at each level.
+    for (std::vector<If *>::reverse_iterator i = chain.rbegin(); i != chain.rend(); ++i) {
+        If *outer = *i;
+        while (!outer->alts.empty()) {
+            IfAlt *alt = outer->alts.back();
+            outer->alts.remove(alt);
+            tail->alts.push_front(alt);
+        }
+    }
 
-    delete act;
+    tail->setCodeInfo(ifStatement->getCodeInfo());
+    for (std::vector<If *>::iterator i = chain.begin(); i != chain.end(); ++i)
+        delete *i;
 
-    return ifStatement;
+    return tail;
 }
 
 If *VerilogParser::parse_ConditionalStatement(
@@ -2370,17 +2720,18 @@ BList<Signal> *VerilogParser::parse_BlockItemDeclaration_Reg(
     // set the range and the type of all registers of the list
     for (BList<Signal>::iterator i = list_of_block_variable_identifiers->begin();
          i != list_of_block_variable_identifiers->end(); ++i) {
-        Array *array_o = dynamic_cast<Array *>((*i)->getType());
+        const bool last = (*i == list_of_block_variable_identifiers->back());
+        Array *array_o  = dynamic_cast<Array *>((*i)->getType());
         if (array_o != nullptr) {
             // create an array of bit with the range 'range_opt'
             //Bitvector *array2 = dynamic_cast<Bitvector*>( getSemanticType( range_opt, signed_opt ) );
 
-            array_o->setType(getSemanticType(range_opt, signed_opt));
+            array_o->setType(_getDeclarationType(range_opt, signed_opt, last));
             array_o->setSigned(false);
         } else {
             // The current Signal is not an Array
             messageAssert((*i)->getType() == nullptr, "Wrong type", *i, nullptr);
-            (*i)->setType(getSemanticType(range_opt, signed_opt));
+            (*i)->setType(_getDeclarationType(range_opt, signed_opt, last));
         }
     }
 
@@ -3182,8 +3533,12 @@ ProcedureCall *VerilogParser::parse_TaskEnable(Value *hierarchical_identifier, B
 
 PortAssign *VerilogParser::parse_NamedPortConnectionList(char *identifier, Value *expression_opt)
 {
-    if (expression_opt == nullptr)
+    if (expression_opt == nullptr) {
+        // An open port: left to bindOpenPortAssigns.
+        _openPortConnection = true;
+        free(identifier);
         return nullptr;
+    }
 
     PortAssign *portAssign_o = new PortAssign();
     setCodeInfo(portAssign_o);
@@ -3201,6 +3556,7 @@ module_instance_and_net_ams_decl_identifier_assignment_t *VerilogParser::parse_M
     module_instance_and_net_ams_decl_identifier_assignment_t *wrapper =
         new module_instance_and_net_ams_decl_identifier_assignment_t();
     wrapper->net_ams_decl_identifier_assignment_list = net_ams_decl_identifier_assignment_list;
+    _openPortConnection                              = false;
 
     return wrapper;
 }
@@ -3243,6 +3599,7 @@ module_instance_and_net_ams_decl_identifier_assignment_t *VerilogParser::parse_M
                 // Ref design: verilog/trusthub/aes_t100_tj
                 setCodeInfo(portAssign_o);
                 delete value_o;
+                _openPortConnection = true;
             } else {
                 setCodeInfo(portAssign_o);
                 portAssign_o->setValue(value_o);
@@ -3254,6 +3611,10 @@ module_instance_and_net_ams_decl_identifier_assignment_t *VerilogParser::parse_M
         delete val_list;
     }
 
+    if (_openPortConnection)
+        ret->addProperty(PROPERTY_OPEN_PORTS);
+    _openPortConnection = false;
+
     module_instance_and_net_ams_decl_identifier_assignment_t *wrapper =
         new module_instance_and_net_ams_decl_identifier_assignment_t();
     wrapper->name_of_module_instance = ret;
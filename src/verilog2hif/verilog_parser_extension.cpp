@@ -9,6 +9,7 @@
 
 #include "verilog2hif/verilog_parser.hpp"
 #include "verilog2hif/support.hpp"
+#include "verilog2hif/udp_table.hpp"
 
 using namespace hif;
 using std::list;
@@ -584,6 +585,54 @@ Value *VerilogParser::_makeValueFromFilter(analog_filter_function_arg_t *arg)
     return agg;
 }
 
+Value *VerilogParser::_makeUdpCode(Value *value)
+{
+    // (value === 1'b0) ? 0 : ((value === 1'b1) ? 1 : 2)
+    When *when_o = new When();
+    setCodeInfoFromCurrentBlock(when_o);
+
+    WhenAlt *zero = new WhenAlt();
+    setCodeInfoFromCurrentBlock(zero);
+    zero->setCondition(_factory.expression(hif::copy(value), op_case_eq, _factory.bitval(bit_zero)));
+    zero->setValue(_factory.intval(static_cast<long long>(UdpTable::CODE_ZERO)));
+    when_o->alts.push_back(zero);
+
+    WhenAlt *one = new WhenAlt();
+    setCodeInfoFromCurrentBlock(one);
+    one->setCondition(_factory.expression(value, op_case_eq, _factory.bitval(bit_one)));
+    one->setValue(_factory.intval(static_cast<long long>(UdpTable::CODE_ONE)));
+    when_o->alts.push_back(one);
+
+    when_o->setDefault(_factory.intval(static_cast<long long>(UdpTable::CODE_X)));
+    when_o->setLogicTernary(true);
+
+    return when_o;
+}
+
+Value *VerilogParser::_makeUdpLookup(const std::string &tableName, Value *index)
+{
+    Member *member_o = new Member();
+    setCodeInfoFromCurrentBlock(member_o);
+    member_o->setPrefix(new Identifier(tableName));
+    member_o->setIndex(index);
+
+    return member_o;
+}
+
+bool VerilogParser::_isChainOperator(const Operator op)
+{
+    // Only operators whose result does not depend on the grouping:
+    // arithmetic ones are excluded since the width of partial sums
+    // depends on the operands they are grouped with.
+    return op == op_band || op == op_bor || op == op_bxor || op == op_and || op == op_or;
+}
+
+Value *VerilogParser::_appendToChain(Value *left, const Operator op, Value *right)
+{
+    return _operatorChains.append(
+        left, op, right, _fileName, static_cast<unsigned int>(yylineno), static_cast<unsigned int>(yycolumno));
+}
+
 System *VerilogParser::buildSystemObject()
 {
     System *system_o = new System();
@@ -13,6 +13,7 @@
  * --------------------------------------------------------------------- */
 std::string yyfilename;
 int yycolumno = 1;
+bool yytraceEnabled = false;
 
 using namespace hif;
 using std::cout;
@@ -28,14 +29,16 @@ using std::string;
 // Initializations.
 /////////////////////////////////////////////////////////////////
 
-const char *HIF_ALL_SENSITIVITY    = "__HIF_ALL_SENSITIVITY";
-const char *NONBLOCKING_ASSIGNMENT = "NONBLOCKING_ASSIGNMENT";
-const char *IS_VARIABLE_TYPE       = "IS_VARIABLE_TYPE";
+const std::string HIF_ALL_SENSITIVITY    = "__HIF_ALL_SENSITIVITY";
+const std::string NONBLOCKING_ASSIGNMENT = "NONBLOCKING_ASSIGNMENT";
+const std::string IS_VARIABLE_TYPE       = "IS_VARIABLE_TYPE";
 
-const char *PROPERTY_SENSITIVE_POS      = "pos";
-const char *PROPERTY_SENSITIVE_NEG      = "neg";
-const char *PROPERTY_TASK_NOT_AUTOMATIC = "PROPERTY_TASK_NOT_AUTOMATIC";
-const char *PROPERTY_GENVAR             = "PROPERTY_GENVAR";
+const std::string PROPERTY_SENSITIVE_POS      = "pos";
+const std::string PROPERTY_SENSITIVE_NEG      = "neg";
+const std::string PROPERTY_TASK_NOT_AUTOMATIC = "PROPERTY_TASK_NOT_AUTOMATIC";
+const std::string PROPERTY_GENVAR             = "PROPERTY_GENVAR";
+const std::string PROPERTY_ALL_SIGNALS        = "ALL_SIGNALS";
+const std::string PROPERTY_OPEN_PORTS         = "OPEN_PORTS";
 
 /////////////////////////////////////////////////////////////////
 // Functions.
@@ -246,14 +249,14 @@ void yywarning(char const *msg, Object *o)
     }
 }
 
-void yydebug(char const *msg, Object *o)
+void yytrace(char const *msg, Object *o)
 {
     assert(msg != nullptr);
-    (*debugStream) << " -- DEBUG: " << msg << " At line " << yylineno << ", column " << yycolumno << endl;
+    (*debugStream) << " -- DEBUG: " << msg << " At line " << yylineno << ", column " << yycolumno << '\n';
 
     if (o != nullptr) {
         hif::writeFile(*debugStream, o, false);
-        *debugStream << std::endl;
+        *debugStream << '\n';
     }
 }
 
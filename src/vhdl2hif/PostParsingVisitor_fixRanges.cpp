@@ -7,7 +7,10 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <map>
 #include <string>
+#include <typeinfo>
+#include <vector>
 
 #include "vhdl2hif/vhdl_parser.hpp"
 #include "vhdl2hif/vhdl_post_parsing_methods.hpp"
@@ -315,45 +318,88 @@ bool _hasSameSignagure(SubProgram *s1, SubProgram *s2)
     return ret;
 }
 
+void _appendTypeKey(Type *t, std::string &key)
+{
+    key += ':';
+    if (t == nullptr)
+        return;
+    key += typeid(*t).name();
+    TypeReference *tr = dynamic_cast<TypeReference *>(t);
+    if (tr != nullptr)
+        key += tr->getName();
+}
+
+/// @brief Returns a key of the signature of the given subprogram: subprograms
+/// with the same signature have the same key, so that the full comparison
+/// is needed only among subprograms with equal keys.
+std::string _getSignatureKey(SubProgram *sub)
+{
+    std::string key = sub->getName();
+    key += (dynamic_cast<Function *>(sub) != nullptr) ? "/f" : "/p";
+    for (BList<Parameter>::iterator i = sub->parameters.begin(); i != sub->parameters.end(); ++i) {
+        Parameter *p = *i;
+        key += ';';
+        _appendTypeKey(p->getType(), key);
+    }
+
+    Function *f = dynamic_cast<Function *>(sub);
+    if (f != nullptr)
+        _appendTypeKey(f->getType(), key);
+
+    return key;
+}
+
 void _fixSubProgramsDeclarations(System *o, hif::semantics::VHDLSemantics *sem)
 {
+    typedef std::vector<SubProgram *> SubPrograms;
+    typedef std::map<std::string, SubPrograms> SignatureMap;
+
     for (BList<LibraryDef>::iterator k = o->libraryDefs.begin(); k != o->libraryDefs.end(); ++k) {
         LibraryDef *l = *k;
         hif::Trash trash;
         if (l->isStandard())
             continue;
+
+        // Subprograms grouped by signature key, in declaration order.
+        SignatureMap signatures;
         for (BList<Declaration>::iterator i = l->declarations.begin(); i != l->declarations.end(); ++i) {
-            Declaration *d    = *i;
-            SubProgram *sub_i = dynamic_cast<SubProgram *>(d);
-            if (sub_i == nullptr)
+            SubProgram *sub = dynamic_cast<SubProgram *>(*i);
+            if (sub == nullptr)
                 continue;
-            BList<Declaration>::iterator j = i;
-            ++j;
-            bool found        = false;
-            SubProgram *sub_j = nullptr;
-            for (; j != l->declarations.end(); ++j) {
-                sub_j = dynamic_cast<SubProgram *>(*j);
-                if (sub_j == nullptr)
-                    continue;
-                if (!_hasSameSignagure(sub_i, sub_j))
-                    continue;
-                found = true;
-                break;
-            }
+            signatures[_getSignatureKey(sub)].push_back(sub);
+        }
 
-            if (!found)
-                continue;
+        for (SignatureMap::iterator s = signatures.begin(); s != signatures.end(); ++s) {
+            SubPrograms &subs = s->second;
+            for (SubPrograms::iterator i = subs.begin(); i != subs.end(); ++i) {
+                SubProgram *sub_i       = *i;
+                SubPrograms::iterator j = i;
+                ++j;
+                bool found        = false;
+                SubProgram *sub_j = nullptr;
+                for (; j != subs.end(); ++j) {
+                    sub_j = *j;
+                    if (!_hasSameSignagure(sub_i, sub_j))
+                        continue;
+                    found = true;
+                    break;
+                }
+
+                if (!found)
+                    continue;
 
-            if ((sub_i->getStateTable() != nullptr && sub_j->getStateTable() != nullptr) ||
-                (sub_i->getStateTable() == nullptr && sub_j->getStateTable() == nullptr)) {
-                messageAssert(
-                    hif::equals(sub_i, sub_j), "Found different subprograms with conflicting declaration", sub_i, sem);
-                trash.insert(sub_j);
-            } else if (sub_i->getStateTable() != nullptr) {
-                trash.insert(sub_j);
-            } else // if (sub_j->getStateTable() != nullptr)
-            {
-                trash.insert(sub_i);
+                if ((sub_i->getStateTable() != nullptr && sub_j->getStateTable() != nullptr) ||
+                    (sub_i->getStateTable() == nullptr && sub_j->getStateTable() == nullptr)) {
+                    messageAssert(
+                        hif::equals(sub_i, sub_j), "Found different subprograms with conflicting declaration", sub_i,
+                        sem);
+                    trash.insert(sub_j);
+                } else if (sub_i->getStateTable() != nullptr) {
+                    trash.insert(sub_j);
+                } else // if (sub_j->getStateTable() != nullptr)
+                {
+                    trash.insert(sub_i);
+                }
             }
         }
 
@@ -7,8 +7,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <list>
+#include <map>
 #include <string>
 
+#include "common/fresh_names.hpp"
 #include "vhdl2hif/vhdl_post_parsing_methods.hpp"
 #include "vhdl2hif/vhdl_support.hpp"
 
@@ -167,10 +170,10 @@ typename T::DeclarationType *_getMethodDeclaration(T *call, hif::semantics::ILan
     return function_o;
 }
 
-void make_template_bounds(ValueTP *&tp_l, ValueTP *&tp_r, Range *o)
+void make_template_bounds(ValueTP *&tp_l, ValueTP *&tp_r, Range *o, FreshNames &freshNames)
 {
-    std::string left  = NameTable::getInstance()->getFreshName("lbound");
-    std::string right = NameTable::getInstance()->getFreshName("rbound");
+    std::string left  = freshNames.get(o, "lbound");
+    std::string right = freshNames.get(o, "rbound");
 
     Int *lint_o = new Int();
     lint_o->setSpan(new Range(31, 0));
@@ -294,6 +297,36 @@ bool _replaceRelationalOperators(Expression &o, hif::semantics::ILanguageSemanti
     return true;
 }
 
+/// @brief The signedness given to logic vectors by the arithmetic package
+/// (ieee.std_logic_signed or ieee.std_logic_unsigned) included in a scope.
+struct SignScope {
+    SignScope();
+    ~SignScope();
+
+    /// The inclusions of the scope, nullptr if no arithmetic package is used.
+    hif::BList<hif::Library> *libraries;
+    bool isSigned;
+    /// Whether ieee_std_logic_arith has already been added to the inclusions.
+    bool hasArith;
+
+private:
+    SignScope(const SignScope &);
+    SignScope &operator=(const SignScope &);
+};
+
+SignScope::SignScope()
+    : libraries(nullptr)
+    , isSigned(false)
+    , hasArith(false)
+{
+    // ntd
+}
+
+SignScope::~SignScope()
+{
+    // ntd
+}
+
 class PostParsingVisitor_step1 : public hif::GuideVisitor
 {
 public:
@@ -303,6 +336,7 @@ public:
     int visitAggregate(hif::Aggregate &o);
     int visitArray(hif::Array &o);
     int visitBitvector(hif::Bitvector &o);
+    int visitContents(hif::Contents &o);
     int visitEnumValue(hif::EnumValue &o);
     int visitExpression(hif::Expression &o);
     int visitFieldReference(hif::FieldReference &o);
@@ -354,7 +388,20 @@ private:
 
     void _fixConstValue(hif::ConstValue &o);
     void _fixTemplateTypereferences(hif::TypeReference *tr, hif::TypeDef *decl);
-    bool _setSignOfArray(hif::Bitvector &o, hif::BList<hif::Library> &libraries);
+
+    /// @name Arithmetic package signedness.
+    /// The signedness is computed once per scope when entering it, and carried
+    /// down the visit, since it changes only at scope boundaries.
+    /// @{
+
+    /// @brief Makes the given scope the current one if it includes an
+    /// arithmetic package.
+    /// @return the previous current scope, to be restored on exit.
+    SignScope *_enterSignScope(SignScope &scope, hif::BList<hif::Library> &libraries);
+    /// @brief Visits an object which may be outside the current scope, like
+    /// a declaration, with the signedness of its own enclosing scopes.
+    void _visitInSignScope(hif::Object *o);
+    /// @}
 
     Value *_refineAggregate2Record(Aggregate &o);
 
@@ -371,6 +418,10 @@ private:
     void _fixBlockStatements(View *o);
     /// @}
 
+    /// @brief Returns the library view matching the given top-level design
+    /// unit among the other design units with its name, or nullptr.
+    View *_getLibraryView(System &o, DesignUnit *currentDu, std::list<DesignUnit *> &candidates);
+
     Value *_fixFunctionCall(FunctionCall *o);
     Value *_fixFunctionCall2TypeRef(FunctionCall *o, TypeReference *typeref, TypeReference::DeclarationType *declTr);
     Value *_fixFunctionCall2MemberOrSlice(FunctionCall *o, Value *currentMember, Declaration *memDecl);
@@ -384,9 +435,14 @@ private:
     bool _haveToFixAggregate;
     bool _addArith;
 
+    /// The innermost visited scope including an arithmetic package, or nullptr.
+    SignScope *_signScope;
+
     RangeMap _rangeMap;
 
     hif::application_utils::WarningSet _unconstrainedGenerics;
+
+    FreshNames _freshNames;
 };
 
 PostParsingVisitor_step1::PostParsingVisitor_step1(hif::semantics::ILanguageSemantics *sem)
@@ -397,8 +453,10 @@ PostParsingVisitor_step1::PostParsingVisitor_step1(hif::semantics::ILanguageSema
     , _haveMeetAggregate(false)
     , _haveToFixAggregate(false)
     , _addArith(false)
+    , _signScope(nullptr)
     , _rangeMap()
     , _unconstrainedGenerics()
+    , _freshNames()
 {
     hif::application_utils::initializeLogHeader("VHDL2HIF", "PostParsingVisitor_step1");
 }
@@ -482,25 +540,19 @@ int PostParsingVisitor_step1::visitBitvector(hif::Bitvector &o)
     GuideVisitor::visitBitvector(o);
     // Set sign of logic vector depending on which header is included.
 
-    Contents *contP = hif::getNearestParent<Contents>(&o);
-    View *viewP     = hif::getNearestParent<View>(&o);
-    LibraryDef *ldP = hif::getNearestParent<LibraryDef>(&o);
-    System *sysP    = hif::getNearestParent<System>(&o);
-    bool isFixed    = false;
-    if (contP != nullptr && !isFixed) {
-        isFixed = _setSignOfArray(o, contP->libraries);
-    }
-    if (viewP != nullptr && !isFixed) {
-        isFixed = _setSignOfArray(o, viewP->libraries);
-    }
-    if (ldP != nullptr && !isFixed) {
-        isFixed = _setSignOfArray(o, ldP->libraries);
-    }
-    if (sysP != nullptr && !isFixed) {
-        isFixed = _setSignOfArray(o, sysP->libraries);
-    }
+    if (_signScope != nullptr) {
+        if (!_signScope->hasArith) {
+            Library arith;
+            arith.setName("ieee_std_logic_arith");
+            hif::manipulation::AddUniqueObjectOptions addOpt;
+            addOpt.equalsOptions.checkOnlyNames = true;
+            addOpt.copyIfUnique                 = true;
+            hif::manipulation::addUniqueObject(&arith, *_signScope->libraries, addOpt);
+            _signScope->hasArith = true;
+            _addArith            = true;
+        }
+        o.setSigned(_signScope->isSigned);
 
-    if (isFixed) {
         Type *t = nullptr;
         if (o.isSigned()) {
             Signed *s = new Signed();
@@ -525,6 +577,62 @@ int PostParsingVisitor_step1::visitBitvector(hif::Bitvector &o)
     return 0;
 }
 
+View *PostParsingVisitor_step1::_getLibraryView(System &o, DesignUnit *currentDu, std::list<DesignUnit *> &candidates)
+{
+    View *view        = currentDu->views.front();
+    ViewReference *vr = new ViewReference();
+    vr->setDesignUnit(currentDu->getName());
+    Variable *fake = new Variable();
+    fake->setType(vr);
+    const bool isComponent = view->getContents() == nullptr;
+    if (isComponent) {
+        Contents *contents_o = new Contents();
+        contents_o->setName(view->getName());
+        view->setContents(contents_o);
+        view->setStandard(true);
+    }
+    view->getContents()->declarations.push_back(fake);
+
+    // For get check this case we use getDeclaration adding a fake var with
+    // a custom viewref type added to DU_2. If declaration is not found
+    // or is the same view, this is not our case. Otherwise that means
+    // that get declaration has found DU_1 inside libraries of DU_2->view.
+    View *libView = hif::semantics::getDeclaration(vr, _sem);
+    if (libView == view) {
+        // Try to search into inclusions of System
+        hif::semantics::DeclarationOptions dopt;
+        dopt.location = &o;
+        libView       = hif::semantics::getDeclaration(vr, _sem, dopt);
+    }
+
+    BList<Declaration>::iterator it(fake);
+    it.erase();
+    if (isComponent) {
+        delete view->setContents(nullptr);
+    }
+
+    if (libView != view && libView != nullptr)
+        return libView;
+
+    // Could be a view declared in a package not used by its implementation.
+    libView = nullptr;
+    for (std::list<DesignUnit *>::iterator j = candidates.begin(); j != candidates.end(); ++j) {
+        DesignUnit *du = *j;
+        if (du == currentDu)
+            continue;
+
+        messageAssert(
+            libView == nullptr,
+            std::string("Found more than one entities with same name,"
+                        " this is not supported yet. Entity name is: ") +
+                du->getName(),
+            nullptr, nullptr);
+        libView = du->views.front();
+    }
+
+    return libView;
+}
+
 int PostParsingVisitor_step1::visitSystem(System &o)
 {
     // Notes: during compiling VHDL (vcom) just looks for components of packages.
@@ -535,9 +643,14 @@ int PostParsingVisitor_step1::visitSystem(System &o)
     hif::HifTypedQuery<DesignUnit> q;
     hif::search(dusList, &o, q);
 
-    typedef std::set<DesignUnit *> DesignUnits;
-    DesignUnits dus;
-    dus.insert(dusList.begin(), dusList.end());
+    // Design units indexed by name: the candidates to match a top-level
+    // design unit are the other ones with its same name.
+    typedef std::list<DesignUnit *> DesignUnits;
+    typedef std::map<std::string, DesignUnits> DesignUnitsIndex;
+    DesignUnitsIndex dus;
+    for (std::list<DesignUnit *>::iterator i = dusList.begin(); i != dusList.end(); ++i) {
+        dus[(*i)->getName()].push_back(*i);
+    }
 
     // In some design parser cannot establish if a design unit is
     // declared inside a design or not. This is the case when the component
@@ -549,57 +662,20 @@ int PostParsingVisitor_step1::visitSystem(System &o)
     // Following code fix this bad parsing by replacing view of DU_1 with
     // view of DU_2 and erasing the DU_2.
     for (BList<DesignUnit>::iterator i = o.designUnits.begin(); i != o.designUnits.end();) {
-        DesignUnit *currentDu = (*i);
-        View *view            = currentDu->views.front();
-        ViewReference *vr     = new ViewReference();
-        vr->setDesignUnit(currentDu->getName());
-        Variable *fake = new Variable();
-        fake->setType(vr);
-        const bool isComponent = view->getContents() == nullptr;
-        if (isComponent) {
-            Contents *contents_o = new Contents();
-            contents_o->setName(view->getName());
-            view->setContents(contents_o);
+        DesignUnit *currentDu   = (*i);
+        DesignUnits &candidates = dus[currentDu->getName()];
+        View *view              = currentDu->views.front();
+        View *libView           = nullptr;
+        // Components without implementation are kept as standard views.
+        if (view->getContents() == nullptr)
             view->setStandard(true);
-        }
-        view->getContents()->declarations.push_back(fake);
-
-        // For get check this case we use getDeclaration adding a fake var with
-        // a custom viewref type added to DU_2. If declaration is not found
-        // or is the same view, this is not our case. Otherwise that means
-        // that get declaration has found DU_1 inside libraries of DU_2->view.
-        View *libView = hif::semantics::getDeclaration(vr, _sem);
-        if (libView == view) {
-            // Try to search into inclusions of System
-            hif::semantics::DeclarationOptions dopt;
-            dopt.location = &o;
-            libView       = hif::semantics::getDeclaration(vr, _sem, dopt);
-        }
-
-        BList<Declaration>::iterator it(fake);
-        it.erase();
-        if (isComponent) {
-            delete view->setContents(nullptr);
-        }
 
-        if (libView == view || libView == nullptr) {
-            // Could be a view declared in a package not used by its implementation.
-            libView = nullptr;
-            for (DesignUnits::iterator j = dus.begin(); j != dus.end(); ++j) {
-                DesignUnit *du = *j;
-                if (du == *i)
-                    continue;
-                if (du->getName() != currentDu->getName())
-                    continue;
-
-                messageAssert(
-                    libView == nullptr,
-                    std::string("Found more than one entities with same name,"
-                                " this is not supported yet. Entity name is: ") +
-                        du->getName(),
-                    nullptr, nullptr);
-                libView = du->views.front();
-            }
+        if (candidates.size() == 2) {
+            // The only other design unit with the same name is the match.
+            DesignUnit *du = (candidates.front() == currentDu) ? candidates.back() : candidates.front();
+            libView        = du->views.front();
+        } else if (candidates.size() > 2) {
+            libView = _getLibraryView(o, currentDu, candidates);
         }
 
         if (libView == view || libView == nullptr) {
@@ -607,16 +683,18 @@ int PostParsingVisitor_step1::visitSystem(System &o)
             continue;
         }
 
-        // moving the current du inside the library definition.
-        libView->replace(hif::copy(view));
+        // moving the current du view inside the library definition.
+        currentDu->views.remove(view);
+        libView->replace(view);
         delete libView;
-        DesignUnits::iterator dusEntry = dus.find(currentDu);
-        if (dusEntry != dus.end())
-            dus.erase(dusEntry);
+        candidates.remove(currentDu);
         i = i.erase();
     }
 
+    SignScope scope;
+    SignScope *restore = _enterSignScope(scope, o.libraries);
     GuideVisitor::visitSystem(o);
+    _signScope = restore;
 
     if (_addArith) {
         hif::manipulation::AddUniqueObjectOptions addOpt;
@@ -627,6 +705,17 @@ int PostParsingVisitor_step1::visitSystem(System &o)
     return 0;
 }
 
+int PostParsingVisitor_step1::visitContents(Contents &o)
+{
+    SignScope scope;
+    SignScope *restore = _enterSignScope(scope, o.libraries);
+
+    GuideVisitor::visitContents(o);
+
+    _signScope = restore;
+    return 0;
+}
+
 int PostParsingVisitor_step1::visitEnumValue(hif::EnumValue &o)
 {
     GuideVisitor::visitEnumValue(o);
@@ -711,7 +800,10 @@ int PostParsingVisitor_step1::visitLibraryDef(LibraryDef &o)
         it.erase();
     }
 
+    SignScope scope;
+    SignScope *restore = _enterSignScope(scope, o.libraries);
     GuideVisitor::visitLibraryDef(o);
+    _signScope = restore;
     return 0;
 }
 
@@ -854,7 +946,10 @@ int PostParsingVisitor_step1::visitView(View &o)
     _fixUselessLibraryInclusions(&o);
     _fixBlockStatements(&o);
 
+    SignScope scope;
+    SignScope *restore = _enterSignScope(scope, o.libraries);
     GuideVisitor::visitView(o);
+    _signScope = restore;
 
     return 0;
 }
@@ -1099,7 +1194,7 @@ bool PostParsingVisitor_step1::fixCollectRanges()
         BList<Declaration>::iterator pos(originalDecl);
         pos.insert_after(newTypedef);
 
-        std::string newName = NameTable::getInstance()->getFreshName(originalDecl->getName(), "_upto");
+        std::string newName = _freshNames.get(originalDecl, originalDecl->getName(), "_upto");
         newTypedef->setName(newName);
 
         for (TypeReferenceSet::iterator j = typerefs.begin(); j != typerefs.end(); ++j) {
@@ -1125,7 +1220,7 @@ void PostParsingVisitor_step1::_fixTemplateTypereferences(hif::TypeReference *tr
 {
     // First of all, assure that declaration is already fixed.
     if (dynamic_cast<Enum *>(decl->getType()) == nullptr) {
-        decl->acceptVisitor(*this);
+        _visitInSignScope(decl);
     }
 
     // If all template parameters are assigned, there is no fix to be done.
@@ -1225,7 +1320,7 @@ void PostParsingVisitor_step1::_fixTemplateTypereferences(hif::TypeReference *tr
 
         // creating and adding the new tp assign
         Identifier *newTp = new Identifier();
-        newTp->setName(hif::NameTable::getInstance()->getFreshName(originalTp->getName()));
+        newTp->setName(_freshNames.get(tr, originalTp->getName()));
 
         ValueTPAssign *vtpa = new ValueTPAssign();
         vtpa->setName(originalTp->getName());
@@ -1284,36 +1379,49 @@ void PostParsingVisitor_step1::_fixTemplateTypereferences(hif::TypeReference *tr
     tr->ranges.clear();
 }
 
-bool PostParsingVisitor_step1::_setSignOfArray(Bitvector &o, BList<Library> &libraries)
+SignScope *PostParsingVisitor_step1::_enterSignScope(SignScope &scope, BList<Library> &libraries)
 {
+    SignScope *restore = _signScope;
     for (BList<Library>::iterator it = libraries.begin(); it != libraries.end(); ++it) {
         if (!(*it)->isSystem())
             continue;
         if ((*it)->getName() == "ieee_std_logic_signed") {
-            Library arith;
-            arith.setName("ieee_std_logic_arith");
-            hif::manipulation::AddUniqueObjectOptions addOpt;
-            addOpt.equalsOptions.checkOnlyNames = true;
-            addOpt.copyIfUnique                 = true;
-            hif::manipulation::addUniqueObject(&arith, libraries, addOpt);
-            _addArith = true;
-
-            o.setSigned(true);
-            return true;
+            scope.isSigned = true;
         } else if ((*it)->getName() == "ieee_std_logic_unsigned") {
-            Library arith;
-            arith.setName("ieee_std_logic_arith");
-            hif::manipulation::AddUniqueObjectOptions addOpt;
-            addOpt.equalsOptions.checkOnlyNames = true;
-            addOpt.copyIfUnique                 = true;
-            hif::manipulation::addUniqueObject(&arith, libraries, addOpt);
-            _addArith = true;
-
-            o.setSigned(false);
-            return true;
+            scope.isSigned = false;
+        } else {
+            continue;
         }
+
+        scope.libraries = &libraries;
+        _signScope      = &scope;
+        break;
     }
-    return false;
+
+    return restore;
+}
+
+void PostParsingVisitor_step1::_visitInSignScope(Object *o)
+{
+    // Same lookup order as the visit: the innermost scope including an
+    // arithmetic package wins.
+    SignScope scope;
+    SignScope *restore = _signScope;
+    _signScope         = nullptr;
+    for (Object *p = o->getParent(); p != nullptr && _signScope == nullptr; p = p->getParent()) {
+        if (dynamic_cast<Contents *>(p) != nullptr)
+            _enterSignScope(scope, static_cast<Contents *>(p)->libraries);
+        else if (dynamic_cast<View *>(p) != nullptr)
+            _enterSignScope(scope, static_cast<View *>(p)->libraries);
+        else if (dynamic_cast<LibraryDef *>(p) != nullptr)
+            _enterSignScope(scope, static_cast<LibraryDef *>(p)->libraries);
+        else if (dynamic_cast<System *>(p) != nullptr)
+            _enterSignScope(scope, static_cast<System *>(p)->libraries);
+    }
+
+    o->acceptVisitor(*this);
+
+    _signScope = restore;
 }
 
 Value *PostParsingVisitor_step1::_refineAggregate2Record(Aggregate &o)
@@ -1399,7 +1507,7 @@ void PostParsingVisitor_step1::_fixRangeTypedrange(Range &o)
 
             ValueTP *tp_l = nullptr;
             ValueTP *tp_r = nullptr;
-            make_template_bounds(tp_l, tp_r, ii->getSpan());
+            make_template_bounds(tp_l, tp_r, ii->getSpan(), _freshNames);
 
             o.setLeftBound(new Identifier(tp_l->getName()));
             o.setRightBound(new Identifier(tp_r->getName()));
@@ -1449,7 +1557,7 @@ void PostParsingVisitor_step1::_fixRangeTypedrange(Range &o)
 
         ValueTP *tp_l = nullptr;
         ValueTP *tp_r = nullptr;
-        make_template_bounds(tp_l, tp_r, &o);
+        make_template_bounds(tp_l, tp_r, &o, _freshNames);
         tdo->templateParameters.push_back(tp_l);
         tdo->templateParameters.push_back(tp_r);
     } else if (paramo != nullptr) {
@@ -1457,7 +1565,7 @@ void PostParsingVisitor_step1::_fixRangeTypedrange(Range &o)
             ValueTP *tp_l = nullptr;
             ValueTP *tp_r = nullptr;
             // this case should be of a lv or bv --> range always positive
-            make_template_bounds(tp_l, tp_r, &o);
+            make_template_bounds(tp_l, tp_r, &o, _freshNames);
 
             SubProgram *parent = (po != nullptr ? static_cast<SubProgram *>(po) : static_cast<SubProgram *>(fo));
 
@@ -1837,7 +1945,7 @@ Value *PostParsingVisitor_step1::_fixFunctionCall(FunctionCall *o)
     std::list<FunctionCall::DeclarationType *> candidates;
     hif::semantics::getCandidates(candidates, o, _sem);
     for (std::list<FunctionCall::DeclarationType *>::iterator i = candidates.begin(); i != candidates.end(); ++i) {
-        (*i)->acceptVisitor(*this);
+        _visitInSignScope(*i);
     }
 
     // Now ensuring correct declaration.
@@ -7,9 +7,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <hif/hif.hpp>
 
@@ -134,6 +136,17 @@ class PostParsingVisitor_step2 : public hif::GuideVisitor
 public:
     typedef std::set<SubProgram *> Operators;
 
+    /// @brief The formal names of a declaration, in declaration order, and
+    /// their positions by name.
+    struct FormalPositions {
+        std::vector<std::string> names;
+        std::map<std::string, std::size_t> positions;
+
+        FormalPositions();
+        ~FormalPositions();
+    };
+    typedef std::map<hif::Object *, FormalPositions> FormalPositionsMap;
+
     PostParsingVisitor_step2(hif::semantics::ILanguageSemantics *sem);
     virtual ~PostParsingVisitor_step2();
 
@@ -160,6 +173,7 @@ private:
     hif::HifFactory _factory;
 
     Operators _operators;
+    FormalPositionsMap _formalPositions;
 
     /// @brief Fix the index of the hif::For, hif::ForGenerate
     ///
@@ -258,6 +272,35 @@ private:
     Value *_getPartial(Value *index, Value *min, hif::Trash &trash, const bool hasTemplates);
     Range *_getPartial(Range *index, Value *min, hif::Trash &trash, const bool hasTemplates);
 
+    /// @brief Records the design unit of an instance with open or missing
+    /// port associations, so that only the design units recorded need open
+    /// ports to be bound.
+    void _recordOpenPorts(Instance *inst);
+
+    /// @brief Fast path of _fixPortPartialBindings for ports of bits bound one
+    /// constant index at a time, as in netlists. Builds the concatenation
+    /// directly in index order, without simplifications.
+    /// @return <tt>false</tt> if the bindings are not all constant, distinct
+    /// scalar indices covering a constant span.
+    bool _fixScalarPartialBindings(Partials &partials, Type *paType);
+    /// @brief Returns the balanced concatenation of the given values, in order.
+    Value *_makeConcat(std::vector<Value *> &values, const std::size_t begin, const std::size_t end);
+
+    /// @}
+
+    /// @name Association-related methods.
+    /// @{
+    /// @brief Sorts the actuals as the given formals, naming the positional ones.
+    /// The formal positions are computed once per declaration, since structural
+    /// descriptions instantiate few entities many times. Falls back to
+    /// hif::manipulation::sortParameters when an actual cannot be placed.
+    /// @param actuals the actual parameters.
+    /// @param formals the formal parameters.
+    /// @param owner the object owning the formals, used as cache key.
+    template <typename T1, typename T2>
+    void _sortAssociations(hif::BList<T1> &actuals, hif::BList<T2> &formals, hif::Object *owner);
+
+    template <typename T> const FormalPositions &_getFormalPositions(hif::BList<T> &formals, hif::Object *owner);
     /// @}
 
     /// @name Attributes fix related methods
@@ -268,10 +311,23 @@ private:
     /// @}
 };
 
+PostParsingVisitor_step2::FormalPositions::FormalPositions()
+    : names()
+    , positions()
+{
+    // ntd
+}
+
+PostParsingVisitor_step2::FormalPositions::~FormalPositions()
+{
+    // ntd
+}
+
 PostParsingVisitor_step2::PostParsingVisitor_step2(hif::semantics::ILanguageSemantics *sem)
     : _sem(sem)
     , _factory(sem)
     , _operators()
+    , _formalPositions()
 {
     // ntd
 }
@@ -377,8 +433,7 @@ int PostParsingVisitor_step2::visitFunctionCall(hif::FunctionCall &o)
         decl->parameters.size() >= o.parameterAssigns.size(),
         "Unexpected number of formal parameter greater than actuals", decl, _sem);
 
-    hif::manipulation::sortParameters(
-        o.parameterAssigns, decl->parameters, true, hif::manipulation::SortMissingKind::NOTHING, _sem);
+    _sortAssociations(o.parameterAssigns, decl->parameters, decl);
 
     if (_fixAttributesDimension(&o))
         return 0;
@@ -388,6 +443,72 @@ int PostParsingVisitor_step2::visitFunctionCall(hif::FunctionCall &o)
     return 0;
 }
 
+template <typename T1, typename T2>
+void PostParsingVisitor_step2::_sortAssociations(BList<T1> &actuals, BList<T2> &formals, Object *owner)
+{
+    if (actuals.empty())
+        return;
+
+    const FormalPositions &formalPositions = _getFormalPositions(formals, owner);
+    const std::string &none                = NameTable::getInstance()->none();
+
+    // Positional actuals precede the named ones, thus their position is their index.
+    std::vector<T1 *> sorted(formalPositions.names.size(), nullptr);
+    std::size_t index = 0;
+    for (typename BList<T1>::iterator i = actuals.begin(); i != actuals.end(); ++i, ++index) {
+        std::size_t position = index;
+        if ((*i)->getName() != none) {
+            std::map<std::string, std::size_t>::const_iterator found = formalPositions.positions.find((*i)->getName());
+            position = (found != formalPositions.positions.end()) ? found->second : sorted.size();
+        }
+
+        if (position >= sorted.size() || sorted[position] != nullptr) {
+            // Let the generic sort handle (or report) unexpected associations.
+            hif::manipulation::sortParameters(
+                actuals, formals, true, hif::manipulation::SortMissingKind::NOTHING, _sem);
+            return;
+        }
+        sorted[position] = *i;
+    }
+
+    for (typename BList<T1>::iterator i = actuals.begin(); i != actuals.end();)
+        i = i.remove();
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        if (sorted[i] == nullptr)
+            continue;
+        sorted[i]->setName(formalPositions.names[i]);
+        actuals.push_back(sorted[i]);
+    }
+}
+
+template <typename T>
+const PostParsingVisitor_step2::FormalPositions &
+PostParsingVisitor_step2::_getFormalPositions(BList<T> &formals, Object *owner)
+{
+    // The owner address may be reused by a new declaration, or the formals
+    // renamed: the entry is valid only if all the names still match.
+    FormalPositions &formalPositions = _formalPositions[owner];
+    if (formalPositions.names.size() == formals.size() && !formals.empty()) {
+        std::size_t index = 0;
+        typename BList<T>::iterator i = formals.begin();
+        for (; i != formals.end(); ++i, ++index) {
+            if (formalPositions.names[index] != (*i)->getName())
+                break;
+        }
+        if (i == formals.end())
+            return formalPositions;
+    }
+
+    formalPositions.names.clear();
+    formalPositions.positions.clear();
+    for (typename BList<T>::iterator i = formals.begin(); i != formals.end(); ++i) {
+        formalPositions.positions[(*i)->getName()] = formalPositions.names.size();
+        formalPositions.names.push_back((*i)->getName());
+    }
+
+    return formalPositions;
+}
+
 bool PostParsingVisitor_step2::_fixAttributesDimension(FunctionCall *o)
 {
     std::string callName = o->getName();
@@ -515,7 +636,10 @@ int PostParsingVisitor_step2::visitInstance(Instance &o)
 {
     _fixPartialBindings(&o);
 
-    for (BList<PortAssign>::iterator it = o.portAssigns.begin(); it != o.portAssigns.end();) {
+    // Open actuals have been recorded by the parser.
+    const bool openPorts = o.checkProperty(OPEN_PORTS_PROPERTY);
+    o.removeProperty(OPEN_PORTS_PROPERTY);
+    for (BList<PortAssign>::iterator it = o.portAssigns.begin(); openPorts && it != o.portAssigns.end();) {
         if ((*it)->getValue() == nullptr) {
             // it is an open portassign. Remove it!
             it = it.erase();
@@ -527,17 +651,20 @@ int PostParsingVisitor_step2::visitInstance(Instance &o)
     messageDebugAssert(o.getReferencedType() != nullptr, "Unexpected nullptr referenced type", &o, _sem);
     ViewReference *vref = dynamic_cast<ViewReference *>(o.getReferencedType());
 
-    if (vref == nullptr)
+    if (vref == nullptr) {
+        if (openPorts)
+            _recordOpenPorts(&o);
         return 0;
+    }
 
     View *vr = hif::semantics::getDeclaration(vref, _sem);
     messageAssert(vr != nullptr, "Not found declaration of view reference.", vref, _sem);
 
-    hif::manipulation::sortParameters(
-        o.portAssigns, vr->getEntity()->ports, true, hif::manipulation::SortMissingKind::NOTHING, _sem);
-    hif::manipulation::sortParameters(
-        vref->templateParameterAssigns, vr->templateParameters, true, hif::manipulation::SortMissingKind::NOTHING,
-        _sem);
+    _sortAssociations(o.portAssigns, vr->getEntity()->ports, vr->getEntity());
+    _sortAssociations(vref->templateParameterAssigns, vr->templateParameters, vr);
+
+    if (openPorts || o.portAssigns.size() < vr->getEntity()->ports.size())
+        _recordOpenPorts(&o);
 
     GuideVisitor::visitInstance(o);
     return 0;
@@ -558,8 +685,7 @@ int PostParsingVisitor_step2::visitProcedureCall(hif::ProcedureCall &o)
         decl->parameters.size() >= o.parameterAssigns.size(),
         "Unexpected number of formal parameter greater than actuals", decl, _sem);
 
-    hif::manipulation::sortParameters(
-        o.parameterAssigns, decl->parameters, true, hif::manipulation::SortMissingKind::NOTHING, _sem);
+    _sortAssociations(o.parameterAssigns, decl->parameters, decl);
 
     return 0;
 }
@@ -1715,7 +1841,10 @@ void PostParsingVisitor_step2::_fixPortPartialBindings(Partials &partials)
     messageAssert(paType != nullptr, "Cannot type description", first, _sem);
 
     const bool hasTemplates = hif::typeDependsOnTemplates(paType, _sem);
-    Value *paTypeMin        = nullptr;
+    if (!hasTemplates && _fixScalarPartialBindings(partials, paType))
+        return;
+
+    Value *paTypeMin = nullptr;
     if (hasTemplates) {
         Range *paTypeRange = hif::typeGetSpan(paType, _sem);
         paTypeMin          = hif::rangeGetMinBound(paTypeRange);
@@ -1764,6 +1893,71 @@ void PostParsingVisitor_step2::_fixPortPartialBindings(Partials &partials)
     delete first->setValue(concat);
 }
 
+bool PostParsingVisitor_step2::_fixScalarPartialBindings(Partials &partials, Type *paType)
+{
+    Range *span = hif::typeGetSpan(paType, _sem);
+    if (span == nullptr || (span->getDirection() != dir_downto && span->getDirection() != dir_upto))
+        return false;
+    IntValue *left  = dynamic_cast<IntValue *>(span->getLeftBound());
+    IntValue *right = dynamic_cast<IntValue *>(span->getRightBound());
+    if (left == nullptr || right == nullptr)
+        return false;
+
+    const bool downto   = span->getDirection() == dir_downto;
+    const long long min = downto ? right->getValue() : left->getValue();
+    const long long max = downto ? left->getValue() : right->getValue();
+    if (max <= min || static_cast<unsigned long long>(max - min + 1) != partials.size())
+        return false;
+
+    Type *elementType = hif::semantics::getVectorElementType(paType, _sem);
+    const bool isBit  = dynamic_cast<Bit *>(elementType) != nullptr;
+    delete elementType;
+    if (!isBit)
+        return false;
+
+    // Concatenation order, i.e. from the left bound.
+    std::vector<PortAssign *> ordered(partials.size(), nullptr);
+    for (Partials::iterator i = partials.begin(); i != partials.end(); ++i) {
+        IntValue *index = dynamic_cast<IntValue *>((*i)->getPartialBind());
+        if (index == nullptr || index->getValue() < min || index->getValue() > max)
+            return false;
+        const std::size_t position =
+            static_cast<std::size_t>(downto ? max - index->getValue() : index->getValue() - min);
+        if (ordered[position] != nullptr)
+            return false;
+        ordered[position] = *i;
+    }
+
+    std::vector<Value *> values;
+    values.reserve(ordered.size());
+    for (std::vector<PortAssign *>::iterator i = ordered.begin(); i != ordered.end(); ++i)
+        values.push_back((*i)->setValue(nullptr));
+    Value *concat = _makeConcat(values, 0, values.size());
+
+    PortAssign *first = *partials.begin();
+    for (Partials::iterator i = partials.begin(); i != partials.end(); ++i) {
+        PortAssign *pa = *i;
+        if (pa == first)
+            continue;
+        pa->replace(nullptr);
+        delete pa;
+    }
+
+    delete first->setPartialBind(nullptr);
+    first->setValue(concat);
+    return true;
+}
+
+Value *
+PostParsingVisitor_step2::_makeConcat(std::vector<Value *> &values, const std::size_t begin, const std::size_t end)
+{
+    // Balanced, to keep the tree shallow on wide buses.
+    if (end - begin == 1)
+        return values[begin];
+    const std::size_t middle = begin + (end - begin) / 2;
+    return _factory.expression(_makeConcat(values, begin, middle), op_concat, _makeConcat(values, middle, end));
+}
+
 Value *PostParsingVisitor_step2::_getPartial(Value *index, Value *min, Trash &trash, const bool hasTemplates)
 {
     if (!hasTemplates)
@@ -1796,6 +1990,15 @@ Range *PostParsingVisitor_step2::_getPartial(Range *index, Value *min, Trash &tr
     return ret;
 }
 
+void PostParsingVisitor_step2::_recordOpenPorts(Instance *inst)
+{
+    Object *scope = hif::getNearestParent<DesignUnit>(inst);
+    if (scope == nullptr)
+        scope = hif::getNearestParent<System>(inst);
+    if (scope != nullptr)
+        scope->addProperty(OPEN_PORTS_PROPERTY);
+}
+
 bool PostParsingVisitor_step2::_fixPartialBindings(Instance *inst)
 {
     PartialNames partialNames;
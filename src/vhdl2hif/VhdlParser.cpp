@@ -27,6 +27,8 @@ BList<DesignUnit> *VhdlParser::du_declarations          = new BList<DesignUnit>(
 BList<LibraryDef> *VhdlParser::lib_declarations         = new BList<LibraryDef>();
 list<architecture_body_t *> *VhdlParser::du_definitions = new list<architecture_body_t *>();
 BList<LibraryDef> *VhdlParser::lib_definitions          = new BList<LibraryDef>();
+VhdlParser::configuration_map_t *VhdlParser::configurations = new VhdlParser::configuration_map_t();
+std::set<Operator> VhdlParser::overloaded_operators;
 
 extern FILE *yyin;  // defined in vhdlParser.cc
 extern FILE *yyout; // defined in vhdlParser.cc
@@ -37,6 +39,24 @@ extern FILE *yyout; // defined in vhdlParser.cc
 int yylex_destroy();
 int yyparse(VhdlParser *parser);
 
+namespace
+{
+
+/// @brief Returns the object to set into the declaration of one identifier
+/// of an identifier list. All identifiers but the last one get a copy,
+/// while the last one takes the parsed object itself, which is reset.
+template <typename T>
+T *_getDeclarationField(T *&parsed, const bool last)
+{
+    if (!last)
+        return hif::copy(parsed);
+    T *ret = parsed;
+    parsed = nullptr;
+    return ret;
+}
+
+} // namespace
+
 VhdlParser::VhdlParser(string fileName)
     : _fileName(fileName)
     , _parseOnly(false)
@@ -52,7 +72,7 @@ VhdlParser::VhdlParser(string fileName)
     , _library_function()
     , _is_vhdl_type()
     , _is_operator_overloading()
-    , _configurationMap()
+    , _operatorChains()
 {
     this->_initStandardLibraries();
     _factory.setSemantics(_sem);
@@ -65,14 +85,6 @@ VhdlParser::~VhdlParser()
     delete _is_vhdl_type;
     delete _is_operator_overloading;
     delete _library_list;
-
-    for (VhdlParser::configuration_map_t::iterator i(_configurationMap.begin()); i != _configurationMap.end(); ++i) {
-        for (component_configuration_map_t::iterator j(i->second.begin()); j != i->second.end(); ++j) {
-            delete j->first;
-            delete j->second->entity_aspect.entity;
-            delete j->second;
-        }
-    }
 }
 
 bool VhdlParser::parse(bool parseOnly)
@@ -225,12 +237,13 @@ architecture_body_t *VhdlParser::parse_ArchitectureBody(
 
             _populateConfigurationMap(config_item, &comp_config_map);
 
+            // Specifications of the same architecture share the same key.
             configuration_map_key_t conf_map_key;
-            conf_map_key.configuration = _name_table->getFreshName();
-            conf_map_key.design_unit   = entityName->getName();
-            conf_map_key.view          = identifier->getName();
+            conf_map_key.design_unit = entityName->getName();
+            conf_map_key.view        = identifier->getName();
 
-            _configurationMap.insert(make_pair(conf_map_key, comp_config_map));
+            component_configuration_map_t &specs = (*configurations)[conf_map_key];
+            specs.insert(comp_config_map.begin(), comp_config_map.end());
 
             delete config_item;
             delete (*i)->configuration_specification;
@@ -727,20 +740,14 @@ void VhdlParser::parse_ConfigurationDeclaration(
     messageDebugAssert(
         block_configuration->block_specification->block_name != nullptr, "Unexpected case", nullptr, _sem);
 
-    if (block_configuration->component_configuration_map->empty()) {
-        delete identifier;
-        delete name;
-        delete block_configuration;
-
-        return;
-    }
-
+    // Configurations without component bindings are recorded as well,
+    // since they still select the architecture of the design unit.
     configuration_map_key_t conf_map_key;
     conf_map_key.configuration = config_name->getName();
     conf_map_key.design_unit   = design_unit->getName();
     conf_map_key.view          = block_configuration->block_specification->block_name->getName();
 
-    _configurationMap[conf_map_key] = *block_configuration->component_configuration_map;
+    (*configurations)[conf_map_key] = *block_configuration->component_configuration_map;
 
     delete block_configuration->component_configuration_map;
     delete block_configuration->block_specification->block_name;
@@ -818,9 +825,9 @@ BList<Declaration> *VhdlParser::parse_ConstantDeclaration(
         Const *c = new Const();
         setCodeInfo(c);
         c->setName((*i)->getName());
-        c->setType(hif::copy(type_o));
+        c->setType(_getDeclarationField(type_o, *i == identifier_list->back()));
         if (expression != nullptr) {
-            c->setValue(hif::copy(expression));
+            c->setValue(_getDeclarationField(expression, *i == identifier_list->back()));
             setCodeInfo(c->getValue());
         }
 
@@ -907,6 +914,15 @@ Identifier *VhdlParser::parse_Designator(Value *id)
             messageError("Unexpected case", nullptr, _sem);
         }
 
+        // User overloads may be non associative: their chains must keep the
+        // grouping of the source.
+        if (val == "and")
+            overloaded_operators.insert(op_and);
+        else if (val == "or")
+            overloaded_operators.insert(op_or);
+        else if (val == "xor")
+            overloaded_operators.insert(op_xor);
+
         identifier = new Identifier();
         identifier->setName(i->second);
         delete id;
@@ -1115,6 +1131,9 @@ Break *VhdlParser::parse_ExitStatement(Identifier *identifier_colon_opt, Identif
 
 Value *VhdlParser::parse_Expression(Value *left_relation, Value *right_relation, Operator op_type)
 {
+    if (_isChainOperator(op_type))
+        return _appendToChain(left_relation, op_type, right_relation);
+
     Expression *v = _factory.expression(left_relation, op_type, right_relation);
     setCodeInfo(v);
     return v;
@@ -1125,6 +1144,9 @@ Value *VhdlParser::parse_ExpressionAND(Value *left_relation, Value *right_relati
     messageAssert(
         right_relation != nullptr, "Unexpected nullptr second operand in binary expression.", left_relation, nullptr);
 
+    if (_isChainOperator(op_and))
+        return _appendToChain(left_relation, op_and, right_relation);
+
     Expression *v = _factory.expression(left_relation, op_and, right_relation);
     setCodeInfo(v);
     return v;
@@ -1939,7 +1961,7 @@ BList<Port> *VhdlParser::parse_InterfaceConstantDeclaration(
         setCodeInfo(port_o);
 
         port_o->setName((*i)->getName());
-        port_o->setType(hif::copy(type_o));
+        port_o->setType(_getDeclarationField(type_o, *i == identifier_list->back()));
 
         if (in_opt) {
             port_o->setDirection(dir_in);
@@ -1948,7 +1970,7 @@ BList<Port> *VhdlParser::parse_InterfaceConstantDeclaration(
         }
 
         if (expression != nullptr) {
-            port_o->setValue(hif::copy(expression));
+            port_o->setValue(_getDeclarationField(expression, *i == identifier_list->back()));
         }
 
         ret->push_back(port_o);
@@ -1980,7 +2002,7 @@ BList<Port> *VhdlParser::parse_InterfaceDeclaration(
         Port *p = new Port();
         setCodeInfo(p);
         p->setName((*i)->getName());
-        p->setType(hif::copy(type_o));
+        p->setType(_getDeclarationField(type_o, *i == identifier_list->back()));
         p->setDirection(mode_opt);
 
         port_list->push_back(p);
@@ -2012,11 +2034,11 @@ BList<Port> *VhdlParser::parse_InterfaceSignalDeclaration(
         setCodeInfo(signal_o);
 
         signal_o->setName((*i)->getName());
-        signal_o->setType(hif::copy(type_o));
+        signal_o->setType(_getDeclarationField(type_o, *i == identifier_list->back()));
         signal_o->setDirection(mode_opt);
 
         if (expression != nullptr) {
-            signal_o->setValue(hif::copy(expression));
+            signal_o->setValue(_getDeclarationField(expression, *i == identifier_list->back()));
         }
 
         ret->push_back(signal_o);
@@ -2049,11 +2071,11 @@ BList<Port> *VhdlParser::parse_InterfaceVariableDeclaration(
         setCodeInfo(signal_o);
 
         signal_o->setName((*i)->getName());
-        signal_o->setType(hif::copy(type_o));
+        signal_o->setType(_getDeclarationField(type_o, *i == identifier_list->back()));
         signal_o->setDirection(mode_opt);
 
         if (expression != nullptr) {
-            signal_o->setValue(hif::copy(expression));
+            signal_o->setValue(_getDeclarationField(expression, *i == identifier_list->back()));
         }
 
         ret->push_back(signal_o);
@@ -2531,8 +2553,8 @@ BList<Declaration> *VhdlParser::parse_SignalDeclaration(
         Signal *s = new Signal();
         setCodeInfo(s);
         s->setName((*i)->getName());
-        s->setType(hif::copy(type_o));
-        s->setValue(hif::copy(expression));
+        s->setType(_getDeclarationField(type_o, *i == identifier_list->back()));
+        s->setValue(_getDeclarationField(expression, *i == identifier_list->back()));
         ret->push_back(s);
     }
 
@@ -2559,7 +2581,7 @@ VhdlParser::parse_SignalDeclaration(BList<Identifier> *identifier_list, subtype_
         Signal *s = new Signal();
         setCodeInfo(s);
         s->setName((*i)->getName());
-        s->setType(hif::copy(type_o));
+        s->setType(_getDeclarationField(type_o, *i == identifier_list->back()));
         ret->push_back(s);
     }
 
@@ -2938,8 +2960,8 @@ BList<Declaration> *VhdlParser::parse_VariableDeclaration(
         Variable *v = new Variable();
         setCodeInfo(v);
         v->setName((*i)->getName());
-        v->setType(hif::copy(type_o));
-        v->setValue(hif::copy(expression));
+        v->setType(_getDeclarationField(type_o, *i == identifier_list->back()));
+        v->setValue(_getDeclarationField(expression, *i == identifier_list->back()));
 
         ret->push_back(v);
     }
@@ -2967,7 +2989,7 @@ VhdlParser::parse_VariableDeclaration(BList<Identifier> *identifier_list, subtyp
         Variable *v = new Variable();
         setCodeInfo(v);
         v->setName((*i)->getName());
-        v->setType(hif::copy(type_o));
+        v->setType(_getDeclarationField(type_o, *i == identifier_list->back()));
 
         ret->push_back(v);
     }
@@ -3135,7 +3157,7 @@ BList<Field> *VhdlParser::parse_ElementDeclaration(BList<Identifier> *identifier
         Field *f = new Field();
         setCodeInfo(f);
         f->setName((*i)->getName());
-        f->setType(hif::copy(element_subtype_definition));
+        f->setType(_getDeclarationField(element_subtype_definition, *i == identifier_list->back()));
         ret->push_back(f);
     }
 
@@ -3559,6 +3581,13 @@ hif::Instance *VhdlParser::parse_ComponentInstantiationStatement(
     }
 
     if (port_map_aspect_opt != nullptr) {
+        for (BList<PortAssign>::iterator i = port_map_aspect_opt->begin(); i != port_map_aspect_opt->end(); ++i) {
+            if ((*i)->getValue() != nullptr)
+                continue;
+            // An open actual: removed by post parsing, and bound later.
+            instance_o->addProperty(OPEN_PORTS_PROPERTY);
+            break;
+        }
         instance_o->portAssigns.merge(*port_map_aspect_opt);
         delete port_map_aspect_opt;
     }
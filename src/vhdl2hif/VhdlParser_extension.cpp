@@ -5,6 +5,8 @@
 /// See LICENSE.md for details.
 
 #include <map>
+#include <set>
+#include <sstream>
 
 #include "vhdl2hif/vhdl_parser.hpp"
 #include "vhdl2hif/vhdl_support.hpp"
@@ -61,6 +63,440 @@ const string std_vhdl_types[] = {
 
 } // namespace
 
+namespace /*anon*/
+{
+
+typedef std::map<std::string, std::set<std::string>> ArchitectureNames;
+typedef std::map<std::string, std::string> ArchitectureSelection;
+typedef std::set<configuration_map_key_t> ConfigurationKeys;
+
+bool _isNamed(const std::string &name) { return !name.empty() && name != NameTable::getInstance()->none(); }
+
+/// @brief Returns the configuration declaration with the given name.
+VhdlParser::configuration_map_t::iterator _findConfiguration(const std::string &name)
+{
+    VhdlParser::configuration_map_t *confs = VhdlParser::configurations;
+    for (VhdlParser::configuration_map_t::iterator i = confs->begin(); i != confs->end(); ++i) {
+        if (i->first.configuration == name)
+            return i;
+    }
+    return confs->end();
+}
+
+/// @brief Selects the given architecture for the given design unit.
+/// The first selection wins.
+void _selectArchitecture(const std::string &duName, const std::string &archName, ArchitectureSelection &selection)
+{
+    ArchitectureSelection::iterator found = selection.find(duName);
+    if (found == selection.end()) {
+        selection[duName] = archName;
+        return;
+    }
+    if (found->second == archName)
+        return;
+
+    const std::string msg = "Design unit '" + duName +
+                            "' is bound to more than one architecture. Keeping architecture '" + found->second +
+                            "'.";
+    raiseUniqueWarning(msg.c_str());
+}
+
+/// @brief Selects the architectures bound by the given configuration,
+/// following the configurations it refers to.
+void _selectArchitectures(
+    VhdlParser::configuration_map_t::iterator conf,
+    ArchitectureSelection &selection,
+    ConfigurationKeys &applied)
+{
+    if (!applied.insert(conf->first).second)
+        return;
+
+    _selectArchitecture(conf->first.design_unit, conf->first.view, selection);
+
+    VhdlParser::component_configuration_map_t &bindings = conf->second;
+    for (VhdlParser::component_configuration_map_t::iterator i = bindings.begin(); i != bindings.end(); ++i) {
+        binding_indication_t *bi = i->second;
+        if (bi == nullptr)
+            continue;
+
+        entity_aspect_t &aspect = bi->entity_aspect;
+        if (aspect.entity != nullptr) {
+            if (_isNamed(aspect.entity->getName()))
+                _selectArchitecture(aspect.entity->getDesignUnit(), aspect.entity->getName(), selection);
+        } else if (aspect.configuration != nullptr) {
+            VhdlParser::configuration_map_t::iterator nested = _findConfiguration(aspect.configuration->getName());
+            if (nested == VhdlParser::configurations->end())
+                messageError("Configuration not found: " + aspect.configuration->getName(), nullptr, nullptr);
+            _selectArchitectures(nested, selection, applied);
+        }
+    }
+}
+
+/// @brief Selects the architectures explicitly instantiated inside the
+/// given contents (i.e. <tt>entity work.du(arch)</tt>).
+void _selectInstantiatedArchitectures(
+    Contents *contents,
+    ArchitectureNames &available,
+    ArchitectureSelection &selection)
+{
+    hif::HifTypedQuery<Instance> q;
+    std::list<Instance *> list;
+    hif::search(list, contents, q);
+
+    for (std::list<Instance *>::iterator i = list.begin(); i != list.end(); ++i) {
+        ViewReference *vr = dynamic_cast<ViewReference *>((*i)->getReferencedType());
+        if (vr == nullptr || !_isNamed(vr->getName()))
+            continue;
+
+        ArchitectureNames::iterator archs = available.find(vr->getDesignUnit());
+        if (archs == available.end() || archs->second.find(vr->getName()) == archs->second.end())
+            continue;
+
+        _selectArchitecture(vr->getDesignUnit(), vr->getName(), selection);
+    }
+}
+
+/// @brief Maps the names of the ports (or generics) of a component to their
+/// actuals in an instance.
+typedef std::map<std::string, Value *> Actuals;
+
+/// @brief Returns the view of the design unit with the given name, looking
+/// first into the given components, then into the given design units.
+View *_findView(const std::string &name, std::list<DesignUnit *> &components, BList<DesignUnit> &designUnits)
+{
+    for (std::list<DesignUnit *>::iterator i = components.begin(); i != components.end(); ++i) {
+        if ((*i)->getName() == name && !(*i)->views.empty())
+            return (*i)->views.back();
+    }
+    for (BList<DesignUnit>::iterator i = designUnits.begin(); i != designUnits.end(); ++i) {
+        if ((*i)->getName() == name && !(*i)->views.empty())
+            return (*i)->views.back();
+    }
+    return nullptr;
+}
+
+Value *_getAssignValue(PortAssign *pa) { return pa->getValue(); }
+
+Value *_getAssignValue(TPAssign *tpa)
+{
+    ValueTPAssign *vtpa = dynamic_cast<ValueTPAssign *>(tpa);
+    messageAssert(vtpa != nullptr, "Unexpected template assign", tpa, nullptr);
+    return vtpa->getValue();
+}
+
+Value *_setAssignValue(PortAssign *pa, Value *value) { return pa->setValue(value); }
+
+Value *_setAssignValue(TPAssign *tpa, Value *value)
+{
+    ValueTPAssign *vtpa = dynamic_cast<ValueTPAssign *>(tpa);
+    messageAssert(vtpa != nullptr, "Unexpected template assign", tpa, nullptr);
+    return vtpa->setValue(value);
+}
+
+/// @brief Returns the name of the declaration at the given position, or an
+/// empty string if there is none.
+template <typename T>
+std::string _getDeclarationName(BList<T> &declarations, const std::size_t position)
+{
+    std::size_t index = 0;
+    for (typename BList<T>::iterator i = declarations.begin(); i != declarations.end(); ++i, ++index) {
+        if (index == position)
+            return (*i)->getName();
+    }
+    return "";
+}
+
+/// @brief Collects the actuals of the given associations of an instance,
+/// resolving positional associations against the given declarations of the
+/// component. Unassociated declarations take their default value.
+template <typename A, typename T>
+void _collectActuals(BList<A> &assigns, BList<T> *declarations, Actuals &actuals)
+{
+    std::size_t index = 0;
+    for (typename BList<A>::iterator i = assigns.begin(); i != assigns.end(); ++i, ++index) {
+        std::string name = (*i)->getName();
+        if (!_isNamed(name) && declarations != nullptr)
+            name = _getDeclarationName(*declarations, index);
+        messageAssert(_isNamed(name), "Cannot resolve positional association", *i, nullptr);
+        actuals[name] = _getAssignValue(*i);
+    }
+
+    if (declarations == nullptr)
+        return;
+    for (typename BList<T>::iterator i = declarations->begin(); i != declarations->end(); ++i) {
+        DataDeclaration *decl = dynamic_cast<DataDeclaration *>(*i);
+        if (decl != nullptr && actuals.find(decl->getName()) == actuals.end())
+            actuals[decl->getName()] = decl->getValue();
+    }
+}
+
+/// @brief Replaces the references to the component ports (or generics) in
+/// the given actual of a binding indication with their actuals in the
+/// instance.
+Value *_replaceLocals(Value *value, const Actuals &locals)
+{
+    if (value == nullptr)
+        return nullptr;
+
+    Identifier *id = dynamic_cast<Identifier *>(value);
+    if (id != nullptr) {
+        Actuals::const_iterator found = locals.find(id->getName());
+        if (found == locals.end())
+            return value;
+        delete value;
+        return found->second != nullptr ? hif::copy(found->second) : nullptr;
+    }
+
+    hif::HifTypedQuery<Identifier> q;
+    std::list<Identifier *> ids;
+    hif::search(ids, value, q);
+    for (std::list<Identifier *>::iterator i = ids.begin(); i != ids.end(); ++i) {
+        Actuals::const_iterator found = locals.find((*i)->getName());
+        if (found == locals.end())
+            continue;
+        messageAssert(found->second != nullptr, "Unsupported open actual inside a binding expression", *i, nullptr);
+        (*i)->replace(hif::copy(found->second));
+        delete *i;
+    }
+    return value;
+}
+
+/// @brief Replaces the associations of an instance with the ones of a
+/// binding indication, whose formals are declared by the bound entity and
+/// whose actuals refer to the component ports (or generics).
+template <typename A, typename T>
+void _bindAssociations(BList<A> &assigns, BList<A> &binding, BList<T> *entityDeclarations, const Actuals &locals)
+{
+    BList<A> bound;
+    std::size_t index = 0;
+    for (typename BList<A>::iterator i = binding.begin(); i != binding.end(); ++i, ++index) {
+        A *assign = hif::copy(*i);
+        if (!_isNamed(assign->getName()) && entityDeclarations != nullptr)
+            assign->setName(_getDeclarationName(*entityDeclarations, index));
+        messageAssert(
+            _isNamed(assign->getName()), "Cannot resolve positional association of binding indication", *i, nullptr);
+        _setAssignValue(assign, _replaceLocals(_setAssignValue(assign, nullptr), locals));
+        bound.push_back(assign);
+    }
+
+    assigns.clear();
+    assigns.merge(bound);
+}
+
+/// @brief Binds the given instance as stated by the given binding
+/// indication: design unit, architecture, generic map and port map.
+void _bindInstance(
+    Instance *inst,
+    binding_indication_t *bi,
+    ArchitectureSelection &selection,
+    std::list<DesignUnit *> &components,
+    BList<DesignUnit> &designUnits)
+{
+    if (bi == nullptr)
+        return;
+
+    ViewReference *vr = dynamic_cast<ViewReference *>(inst->getReferencedType());
+    std::string duName;
+    std::string archName;
+    entity_aspect_t &aspect = bi->entity_aspect;
+    if (aspect.entity != nullptr) {
+        duName = aspect.entity->getDesignUnit();
+        if (_isNamed(aspect.entity->getName()))
+            archName = aspect.entity->getName();
+    } else if (aspect.configuration != nullptr) {
+        VhdlParser::configuration_map_t::iterator conf = _findConfiguration(aspect.configuration->getName());
+        if (conf == VhdlParser::configurations->end())
+            messageError("Configuration not found: " + aspect.configuration->getName(), inst, nullptr);
+        duName   = conf->first.design_unit;
+        archName = conf->first.view;
+    } else {
+        return;
+    }
+
+    // Only one architecture per design unit is kept.
+    ArchitectureSelection::iterator found = selection.find(duName);
+    if (archName.empty() && found != selection.end())
+        archName = found->second;
+    if (!archName.empty() && found != selection.end() && found->second != archName) {
+        messageError(
+            "Instance '" + inst->getName() + "' is bound to architecture '" + archName + "' of design unit '" +
+                duName + "', while architecture '" + found->second + "' is used elsewhere",
+            inst, nullptr);
+    }
+
+    View *component = _findView(vr->getDesignUnit(), components, designUnits);
+    View *entity    = _findView(duName, components, designUnits);
+
+    if (bi->generic_map_aspect != nullptr) {
+        Actuals locals;
+        _collectActuals(
+            vr->templateParameterAssigns, component != nullptr ? &component->templateParameters : nullptr, locals);
+        _bindAssociations(
+            vr->templateParameterAssigns, *bi->generic_map_aspect,
+            entity != nullptr ? &entity->templateParameters : nullptr, locals);
+    }
+    if (bi->port_map_aspect != nullptr) {
+        Actuals locals;
+        _collectActuals(
+            inst->portAssigns, component != nullptr ? &component->getEntity()->ports : nullptr, locals);
+        _bindAssociations(
+            inst->portAssigns, *bi->port_map_aspect, entity != nullptr ? &entity->getEntity()->ports : nullptr,
+            locals);
+        for (BList<PortAssign>::iterator i = inst->portAssigns.begin(); i != inst->portAssigns.end(); ++i) {
+            if ((*i)->getValue() != nullptr)
+                continue;
+            inst->addProperty(OPEN_PORTS_PROPERTY);
+            break;
+        }
+    }
+
+    vr->setDesignUnit(duName);
+    if (!archName.empty())
+        vr->setName(archName);
+}
+
+/// @brief Binds the component instances of the given contents.
+/// Named instances take precedence over <tt>all</tt> and <tt>others</tt>.
+void _applyBindings(
+    Contents *contents,
+    VhdlParser::component_configuration_map_t &bindings,
+    ArchitectureSelection &selection,
+    std::list<DesignUnit *> &components,
+    BList<DesignUnit> &designUnits)
+{
+    if (bindings.empty())
+        return;
+
+    hif::HifTypedQuery<Instance> q;
+    std::list<Instance *> list;
+    hif::search(list, contents, q);
+
+    std::set<Instance *> bound;
+    for (int pass = 0; pass < 3; ++pass) {
+        for (VhdlParser::component_configuration_map_t::iterator i = bindings.begin(); i != bindings.end(); ++i) {
+            Instance *spec     = i->first;
+            const bool all     = spec->checkProperty("CONFIGURATION_ALL");
+            const bool others  = spec->checkProperty("CONFIGURATION_OTHERS");
+            const int specPass = all ? 1 : (others ? 2 : 0);
+            if (specPass != pass)
+                continue;
+
+            ViewReference *component = dynamic_cast<ViewReference *>(spec->getReferencedType());
+            messageAssert(component != nullptr, "Unexpected component specification", spec, nullptr);
+
+            for (std::list<Instance *>::iterator j = list.begin(); j != list.end(); ++j) {
+                Instance *inst = *j;
+                if (dynamic_cast<BaseContents *>(inst->getParent()) == nullptr)
+                    continue;
+                ViewReference *vr = dynamic_cast<ViewReference *>(inst->getReferencedType());
+                if (vr == nullptr || vr->getDesignUnit() != component->getDesignUnit())
+                    continue;
+                if (specPass == 0 && inst->getName() != spec->getName())
+                    continue;
+                if (!bound.insert(inst).second)
+                    continue;
+
+                _bindInstance(inst, i->second, selection, components, designUnits);
+            }
+        }
+    }
+}
+
+/// @brief Selects the architectures bound by the configuration
+/// specifications of the architectures already known to be kept, i.e. the
+/// selected ones and the only architecture of a design unit, until no new
+/// architecture is selected.
+void _selectSpecifiedArchitectures(
+    ArchitectureNames &available,
+    ArchitectureSelection &selection,
+    ConfigurationKeys &applied,
+    ConfigurationKeys &visited)
+{
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (ArchitectureNames::iterator i = available.begin(); i != available.end(); ++i) {
+            configuration_map_key_t specKey;
+            specKey.design_unit                   = i->first;
+            ArchitectureSelection::iterator found = selection.find(i->first);
+            if (found != selection.end())
+                specKey.view = found->second;
+            else if (i->second.size() == 1)
+                specKey.view = *i->second.begin();
+            else
+                continue;
+
+            VhdlParser::configuration_map_t::iterator specs = VhdlParser::configurations->find(specKey);
+            if (specs == VhdlParser::configurations->end() || !visited.insert(specKey).second)
+                continue;
+
+            const std::size_t selected = selection.size();
+            VhdlParser::component_configuration_map_t &bindings = specs->second;
+            for (VhdlParser::component_configuration_map_t::iterator j = bindings.begin(); j != bindings.end();
+                 ++j) {
+                binding_indication_t *bi = j->second;
+                if (bi == nullptr)
+                    continue;
+                entity_aspect_t &aspect = bi->entity_aspect;
+                if (aspect.entity != nullptr) {
+                    if (_isNamed(aspect.entity->getName()))
+                        _selectArchitecture(aspect.entity->getDesignUnit(), aspect.entity->getName(), selection);
+                } else if (aspect.configuration != nullptr) {
+                    VhdlParser::configuration_map_t::iterator conf =
+                        _findConfiguration(aspect.configuration->getName());
+                    if (conf == VhdlParser::configurations->end())
+                        messageError("Configuration not found: " + aspect.configuration->getName(), nullptr, nullptr);
+                    _selectArchitectures(conf, selection, applied);
+                }
+            }
+            changed = changed || selection.size() != selected;
+        }
+    }
+}
+
+/// @brief Applies the configuration declarations of the design units having
+/// several architectures, none of them selected yet. A design unit with a
+/// single configuration declaration is configured by it, otherwise the
+/// default binding is used, with a warning.
+void _selectDeclaredConfigurations(
+    ArchitectureNames &available,
+    ArchitectureSelection &selection,
+    ConfigurationKeys &applied)
+{
+    for (ArchitectureNames::iterator i = available.begin(); i != available.end(); ++i) {
+        if (i->second.size() < 2 || selection.find(i->first) != selection.end())
+            continue;
+
+        VhdlParser::configuration_map_t::iterator declared = VhdlParser::configurations->end();
+        unsigned int count                                 = 0;
+        VhdlParser::configuration_map_t *confs             = VhdlParser::configurations;
+        for (VhdlParser::configuration_map_t::iterator j = confs->begin(); j != confs->end(); ++j) {
+            if (j->first.design_unit != i->first || j->first.configuration.empty())
+                continue;
+            declared = j;
+            ++count;
+        }
+
+        if (count == 1) {
+            messageInfo(
+                "Applying configuration '" + declared->first.configuration + "' to design unit '" + i->first + "'");
+            _selectArchitectures(declared, selection, applied);
+        } else if (count > 1) {
+            const std::string msg = "Design unit '" + i->first +
+                                    "' has several configurations: select one with --configuration. "
+                                    "Using the most recently analyzed architecture.";
+            raiseUniqueWarning(msg.c_str());
+        } else {
+            const std::string msg = "Design unit '" + i->first +
+                                    "' has several architectures, and none is selected by a configuration. "
+                                    "Using the most recently analyzed architecture.";
+            raiseUniqueWarning(msg.c_str());
+        }
+    }
+}
+
+} // namespace
+
 void VhdlParser::_initStandardLibraries()
 {
     _is_vhdl_type =
@@ -200,17 +636,81 @@ ReferencedType *VhdlParser::_resolveFieldReferenceType(FieldReference *fr)
     return ret;
 }
 
-System *VhdlParser::buildSystemObject()
+System *VhdlParser::buildSystemObject(const std::string &configuration)
 {
     System *system_o = new System();
     system_o->setName("system");
 
+    // Available architectures of each design unit.
+    ArchitectureNames available;
     for (list<architecture_body_t *>::iterator ai = du_definitions->begin(); ai != du_definitions->end(); ++ai) {
         architecture_body_t *archBody = *ai;
         messageAssert(archBody != nullptr, "Unexpected nullptr", nullptr, nullptr);
+        available[archBody->entity_name->getName()].insert(archBody->contents->getName());
+    }
+
+    // Architectures selected by the requested configuration, then by explicit
+    // entity instantiations.
+    ArchitectureSelection selection;
+    ConfigurationKeys applied;
+    if (!configuration.empty()) {
+        configuration_map_t::iterator conf = _findConfiguration(configuration);
+        if (conf == configurations->end())
+            messageError("Configuration not found: " + configuration, nullptr, nullptr);
+        _selectArchitectures(conf, selection, applied);
+    }
+    for (list<architecture_body_t *>::iterator ai = du_definitions->begin(); ai != du_definitions->end(); ++ai) {
+        _selectInstantiatedArchitectures((*ai)->contents, available, selection);
+    }
+
+    // Then by the configuration specifications of the kept architectures and,
+    // without a requested configuration, by the configuration declarations.
+    ConfigurationKeys visited;
+    _selectSpecifiedArchitectures(available, selection, applied, visited);
+    if (configuration.empty()) {
+        _selectDeclaredConfigurations(available, selection, applied);
+        _selectSpecifiedArchitectures(available, selection, applied, visited);
+    }
+
+    // Any other design unit uses the default binding, i.e. the most recently
+    // analyzed architecture.
+    typedef std::map<std::string, architecture_body_t *> Architectures;
+    Architectures chosen;
+    for (list<architecture_body_t *>::iterator ai = du_definitions->begin(); ai != du_definitions->end(); ++ai) {
+        architecture_body_t *archBody         = *ai;
+        const std::string duName              = archBody->entity_name->getName();
+        ArchitectureSelection::iterator found = selection.find(duName);
+        if (found == selection.end() || found->second == archBody->contents->getName())
+            chosen[duName] = archBody;
+    }
+    for (ArchitectureSelection::iterator i = selection.begin(); i != selection.end(); ++i) {
+        if (available.find(i->first) == available.end())
+            continue; // e.g. entities implemented by other libraries
+        if (chosen.find(i->first) != chosen.end())
+            continue;
+        messageError(
+            "Architecture '" + i->second + "' of design unit '" + i->first + "' not found", nullptr, nullptr);
+    }
+
+    unsigned int dropped = 0;
+    for (list<architecture_body_t *>::iterator ai = du_definitions->begin(); ai != du_definitions->end(); ++ai) {
+        architecture_body_t *archBody = *ai;
+        const std::string duName      = archBody->entity_name->getName();
+
+        if (chosen[duName] != archBody) {
+            // Not selected: dropping it.
+            ++dropped;
+            delete archBody->contents;
+            for (std::list<DesignUnit *>::iterator i = archBody->components.begin(); i != archBody->components.end();
+                 ++i) {
+                delete *i;
+            }
+            delete archBody;
+            continue;
+        }
 
         for (BList<DesignUnit>::iterator dui = du_declarations->begin(); dui != du_declarations->end(); ++dui) {
-            if ((*dui)->getName() == archBody->entity_name->getName()) {
+            if ((*dui)->getName() == duName) {
                 Contents *old = (*dui)->views.back()->setContents(archBody->contents);
                 messageAssert(old == nullptr, "Multiple architectures are not supported yet", *dui, nullptr);
                 (*dui)->views.back()->setName(archBody->contents->getName());
@@ -219,6 +719,21 @@ System *VhdlParser::buildSystemObject()
             }
         }
 
+        // Binding component instances: first the configuration
+        // specifications of the architecture, then the applied configurations.
+        configuration_map_key_t specKey;
+        specKey.design_unit = duName;
+        specKey.view        = archBody->contents->getName();
+        configuration_map_t::iterator specs = configurations->find(specKey);
+        if (specs != configurations->end())
+            _applyBindings(archBody->contents, specs->second, selection, archBody->components, *du_declarations);
+        for (ConfigurationKeys::iterator i = applied.begin(); i != applied.end(); ++i) {
+            if (i->design_unit != specKey.design_unit || i->view != specKey.view)
+                continue;
+            _applyBindings(
+                archBody->contents, (*configurations)[*i], selection, archBody->components, *du_declarations);
+        }
+
         for (std::list<DesignUnit *>::iterator i = archBody->components.begin(); i != archBody->components.end(); ++i) {
             DesignUnit *comp = *i;
 
@@ -238,6 +753,12 @@ System *VhdlParser::buildSystemObject()
     }
     system_o->designUnits.merge(*du_declarations);
 
+    if (dropped != 0) {
+        std::stringstream ss;
+        ss << "Dropped " << dropped << " architecture(s) not selected by configuration or default binding";
+        messageInfo(ss.str());
+    }
+
     for (BList<LibraryDef>::iterator libi = lib_declarations->begin(); libi != lib_declarations->end(); ++libi) {
         for (BList<LibraryDef>::iterator packi = lib_definitions->begin(); packi != lib_definitions->end(); ++packi) {
             if ((*libi)->getName() == (*packi)->getName()) {
@@ -249,10 +770,32 @@ System *VhdlParser::buildSystemObject()
     }
     system_o->libraryDefs.merge(*lib_declarations);
 
+    // Cleaning up configurations. The same binding indication can be shared
+    // by many instances of a specification.
+    std::set<binding_indication_t *> bindings;
+    for (configuration_map_t::iterator i = configurations->begin(); i != configurations->end(); ++i) {
+        for (component_configuration_map_t::iterator j = i->second.begin(); j != i->second.end(); ++j) {
+            delete j->first;
+            bindings.insert(j->second);
+        }
+    }
+    for (std::set<binding_indication_t *>::iterator i = bindings.begin(); i != bindings.end(); ++i) {
+        binding_indication_t *bi = *i;
+        if (bi == nullptr)
+            continue;
+        delete bi->entity_aspect.entity;
+        delete bi->entity_aspect.configuration;
+        delete bi->generic_map_aspect;
+        delete bi->port_map_aspect;
+        delete bi;
+    }
+
     delete du_definitions;
     delete lib_definitions;
     delete du_declarations;
     delete lib_declarations;
+    delete configurations;
+    overloaded_operators.clear();
 
     return system_o;
 }
@@ -350,3 +893,16 @@ void VhdlParser::_fixIntancesWithComponent(Contents *contents, View *component)
         }
     }
 }
+
+bool VhdlParser::_isChainOperator(const Operator op)
+{
+    if (op != op_and && op != op_or && op != op_xor)
+        return false;
+    return overloaded_operators.find(op) == overloaded_operators.end();
+}
+
+Value *VhdlParser::_appendToChain(Value *left, const Operator op, Value *right)
+{
+    return _operatorChains.append(
+        left, op, right, _fileName, static_cast<unsigned int>(yylineno), static_cast<unsigned int>(yycolumno));
+}
@@ -23,6 +23,7 @@
 // Tool includes
 /////////////////////////////////////////
 
+#include "common/stage_checkpoints.hpp"
 #include "vhdl2hif/vhdl2hifParseLine.hpp"
 #include "vhdl2hif/vhdl_post_parsing_methods.hpp"
 
@@ -30,6 +31,7 @@
 // Other includes
 /////////////////////////////////////////
 #include "vhdl2hif/vhdl_parser.hpp"
+#include "vhdl2hif/vhdl_support.hpp"
 
 /////////////////////////////////////////
 // Namespaces
@@ -69,6 +71,27 @@ namespace
 
 hif::application_utils::StepFileManager _stepFileManager;
 
+/// @brief The stages after which a checkpoint can be written, in execution order.
+const char *const _stages[] = {"parsing", "ranges", "step1", "step2", "standardization", "bindOpenPorts"};
+const int _stagesNumber     = static_cast<int>(sizeof(_stages) / sizeof(_stages[0]));
+
+StageCheckpoints _checkpoints(_stages, _stagesNumber, "CHECKPOINT_PSL_MIXED");
+
+/// @brief Returns true if some design unit has been recorded with instances
+/// having open or missing port associations, clearing the records.
+bool _takeOpenPortsRecords(System *systOb)
+{
+    bool ret = systOb->checkProperty(OPEN_PORTS_PROPERTY);
+    systOb->removeProperty(OPEN_PORTS_PROPERTY);
+    for (BList<DesignUnit>::iterator i = systOb->designUnits.begin(); i != systOb->designUnits.end(); ++i) {
+        if (!(*i)->checkProperty(OPEN_PORTS_PROPERTY))
+            continue;
+        (*i)->removeProperty(OPEN_PORTS_PROPERTY);
+        ret = true;
+    }
+    return ret;
+}
+
 } // namespace
 
 /////////////////////////////////////////
@@ -77,7 +100,7 @@ hif::application_utils::StepFileManager _stepFileManager;
 
 /// @brief Perform some refine of Hif description before the standardization.
 /// The refinements must maintain correctness with the VHDL semantics.
-void postParsingRefinements(System *systOb, bool useInt32);
+void postParsingRefinements(System *systOb, bool useInt32, const bool pslMixed);
 
 /// @brief Perform some essential refines of Hif description for the printing
 /// of HIF tree with printOnly option.
@@ -106,7 +129,8 @@ int main(int argc, char *argv[])
     hif::application_utils::setVerboseLog(cLine.isVerbose());
     if (cLine.isWriteParsing()) {
         delete debugStream;
-        debugStream = errorStream;
+        debugStream    = errorStream;
+        yytraceEnabled = true;
     }
 
     // Retrieve input files list
@@ -120,20 +144,29 @@ int main(int argc, char *argv[])
         outputFile = fs.getAbsolutePath();
     }
 
-    bool pslMixed = false;
+    const std::string checkpointStage = cLine.getCheckpointStage();
+    if (!checkpointStage.empty())
+        _checkpoints.setCheckpointStage(checkpointStage, outputFile);
 
-    // PARSING SECTION
-    for (vhdl2hifParseLine::Files::iterator it = inputFiles.begin(); it != inputFiles.end(); ++it) {
-        VhdlParser parser(*it);
+    bool pslMixed  = false;
+    System *systOb = nullptr;
 
-        if (!parser.parse(cLine.isParseOnly())) {
-            string msg("Cannot parse file '");
-            msg = msg.append(*it);
-            msg = msg.append("'");
-            messageError(msg, nullptr, nullptr);
+    if (!cLine.getResumeFile().empty()) {
+        systOb = _checkpoints.resume(cLine.getResumeFile(), pslMixed);
+    } else {
+        // PARSING SECTION
+        for (vhdl2hifParseLine::Files::iterator it = inputFiles.begin(); it != inputFiles.end(); ++it) {
+            VhdlParser parser(*it);
+
+            if (!parser.parse(cLine.isParseOnly())) {
+                string msg("Cannot parse file '");
+                msg = msg.append(*it);
+                msg = msg.append("'");
+                messageError(msg, nullptr, nullptr);
+            }
+
+            pslMixed |= parser.isPslMixed();
         }
-
-        pslMixed |= parser.isPslMixed();
     }
 
     auto *vhdlLanguage = hif::semantics::VHDLSemantics::getInstance();
@@ -141,14 +174,16 @@ int main(int argc, char *argv[])
     vhdlLanguage->setUsePsl(pslMixed);
     auto *hifLanguage = hif::semantics::HIFSemantics::getInstance();
 
-    // Match DesignUnits/Packages definitions with declarations collected during
-    // the parsing stage. Than, populate the System object.
-    System *systOb = VhdlParser::buildSystemObject();
+    if (systOb == nullptr) {
+        // Match DesignUnits/Packages definitions with declarations collected during
+        // the parsing stage. Than, populate the System object.
+        systOb = VhdlParser::buildSystemObject(cLine.getConfiguration());
 
-    // Add psl standard library (if needed)
-    if (pslMixed) {
-        messageInfo("Found some PSL properties in the input files.");
-        systOb->libraryDefs.push_back(vhdlLanguage->getStandardLibrary("psl_standard"));
+        // Add psl standard library (if needed)
+        if (pslMixed) {
+            messageInfo("Found some PSL properties in the input files.");
+            systOb->libraryDefs.push_back(vhdlLanguage->getStandardLibrary("psl_standard"));
+        }
     }
 
     if (cLine.isParseOnly()) {
@@ -179,19 +214,29 @@ int main(int argc, char *argv[])
     }
 
     _stepFileManager.printStep(systOb, "parsing_result");
+    _checkpoints.checkpoint(systOb, "parsing", pslMixed);
 
-    postParsingRefinements(systOb, cLine.useInt32());
+    postParsingRefinements(systOb, cLine.useInt32(), pslMixed);
 
     // Standardize description.
-    messageInfo("Performing standardization");
-    _stepFileManager.startStep("STD");
-    standardizeDescription(systOb, vhdlLanguage, hifLanguage, &_stepFileManager);
-    _stepFileManager.endStep(systOb);
+    if (_checkpoints.mustRun("standardization")) {
+        messageInfo("Performing standardization");
+        _stepFileManager.startStep("STD");
+        standardizeDescription(systOb, vhdlLanguage, hifLanguage, &_stepFileManager);
+        _stepFileManager.endStep(systOb);
+        _checkpoints.checkpoint(systOb, "standardization", pslMixed);
+    }
 
     // Bind open port assigns.
-    messageInfo("Binding open ports (if any)");
-    hif::manipulation::bindOpenPortAssigns(*systOb);
-    _stepFileManager.printStep(systOb, "bindOpenPortAssigns");
+    if (_checkpoints.mustRun("bindOpenPorts")) {
+        // Instances with open ports have been recorded by step 2.
+        if (_takeOpenPortsRecords(systOb)) {
+            messageInfo("Binding open ports");
+            hif::manipulation::bindOpenPortAssigns(*systOb);
+        }
+        _stepFileManager.printStep(systOb, "bindOpenPortAssigns");
+        _checkpoints.checkpoint(systOb, "bindOpenPorts", pslMixed);
+    }
 
     // Print translation warnings
     printUniqueWarnings("During translation, one or more warnings have been raised:");
@@ -235,37 +280,46 @@ int main(int argc, char *argv[])
 // Utility functions implementations
 /////////////////////////////////////////
 
-void postParsingRefinements(System *systOb, bool useInt32)
+void postParsingRefinements(System *systOb, bool useInt32, const bool pslMixed)
 {
     hif::semantics::VHDLSemantics *vhdlSemantics = hif::semantics::VHDLSemantics::getInstance();
 
-    // Fix ranges and libraries
-    messageInfo("Performing post-parsing refinements on ranges");
-    performRangeRefinements(systOb, useInt32, vhdlSemantics);
-    _stepFileManager.printStep(systOb, "performRangeRefinements");
+    if (_checkpoints.mustRun("ranges")) {
+        // Fix ranges and libraries
+        messageInfo("Performing post-parsing refinements on ranges");
+        performRangeRefinements(systOb, useInt32, vhdlSemantics);
+        _stepFileManager.printStep(systOb, "performRangeRefinements");
+        _checkpoints.checkpoint(systOb, "ranges", pslMixed);
+    }
 
-    // Add vhdl standard package
-    vhdlSemantics->addStandardPackages(systOb);
-    _stepFileManager.printStep(systOb, "standardPackagesRefines");
+    if (_checkpoints.mustRun("step1")) {
+        // Add vhdl standard package
+        vhdlSemantics->addStandardPackages(systOb);
+        _stepFileManager.printStep(systOb, "standardPackagesRefines");
 
-    // First Post parsing visitor
-    messageInfo("Performing post-parsing refinements - step 1");
-    performStep1Refinements(systOb, vhdlSemantics);
-    _stepFileManager.printStep(systOb, "performStep1Refinements");
+        // First Post parsing visitor
+        messageInfo("Performing post-parsing refinements - step 1");
+        performStep1Refinements(systOb, vhdlSemantics);
+        _stepFileManager.printStep(systOb, "performStep1Refinements");
+        _checkpoints.checkpoint(systOb, "step1", pslMixed);
+    }
 
-    // Reset bad declarations and types set in parsing and update all declarations.
-    hif::manipulation::flushInstanceCache();
-    hif::semantics::flushTypeCacheEntries();
-    hif::semantics::resetTypes(systOb);
-    hif::semantics::UpdateDeclarationOptions dopt;
-    dopt.forceRefresh    = true;
-    dopt.looseTypeChecks = true;
-    updateDeclarations(systOb, vhdlSemantics, dopt);
-
-    // Second Post parsing visitor
-    messageInfo("Performing post-parsing refinements - step 2");
-    performStep2Refinements(systOb, vhdlSemantics);
-    _stepFileManager.printStep(systOb, "performStep2Refinements");
+    if (_checkpoints.mustRun("step2")) {
+        // Reset bad declarations and types set in parsing and update all declarations.
+        hif::manipulation::flushInstanceCache();
+        hif::semantics::flushTypeCacheEntries();
+        hif::semantics::resetTypes(systOb);
+        hif::semantics::UpdateDeclarationOptions dopt;
+        dopt.forceRefresh    = true;
+        dopt.looseTypeChecks = true;
+        updateDeclarations(systOb, vhdlSemantics, dopt);
+
+        // Second Post parsing visitor
+        messageInfo("Performing post-parsing refinements - step 2");
+        performStep2Refinements(systOb, vhdlSemantics);
+        _stepFileManager.printStep(systOb, "performStep2Refinements");
+        _checkpoints.checkpoint(systOb, "step2", pslMixed);
+    }
 }
 
 void performPrintOnlyRefinements(System *systOb)
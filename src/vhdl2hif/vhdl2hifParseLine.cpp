@@ -4,6 +4,8 @@
 /// This file is distributed under the BSD 2-Clause License.
 /// See LICENSE.md for details.
 
+#include <cctype>
+
 #include "vhdl2hif/vhdl2hifParseLine.hpp"
 
 vhdl2hifParseLine::vhdl2hifParseLine(int argc, char *argv[])
@@ -43,6 +45,18 @@ vhdl2hifParseLine::vhdl2hifParseLine(int argc, char *argv[])
         'i', "integers", false, useSynthesisIntAvaiable,
         "(Experimental) Translate integers using span computed from "
         "specified range, instead of assuming span of 32 bits.");
+    addOption(
+        'c', "configuration", true, true,
+        "Name of the VHDL configuration used to select architectures. "
+        "Architectures not selected by it or by default binding are dropped.");
+    addOption(
+        'k', "checkpoint-after", true, true,
+        "Write a checkpoint of the translation after the given stage: parsing, "
+        "ranges, step1, step2, standardization or bindOpenPorts.");
+    addOption(
+        'r', "resume-from", true, true,
+        "Resume the translation from a checkpoint file, skipping the stages "
+        "it has been written after. No input files are needed.");
 
     parse(argc, argv);
 
@@ -61,7 +75,7 @@ void vhdl2hifParseLine::_validateArguments()
     if (!_options['v'].value.empty())
         printVersion();
 
-    if (_files.empty()) {
+    if (_files.empty() && _options['r'].value.empty()) {
         messageError(
             "VHDL input file missing.\n"
             "Try 'vhdl2hif --help' for more information",
@@ -103,3 +117,17 @@ std::string vhdl2hifParseLine::_cleanFileName(std::string inputString)
 }
 
 bool vhdl2hifParseLine::useInt32() { return getOption('i').empty(); }
+
+std::string vhdl2hifParseLine::getConfiguration()
+{
+    // VHDL identifiers are stored lowercase by the lexer.
+    std::string configuration = getOption('c');
+    for (std::string::size_type i = 0; i < configuration.size(); ++i) {
+        configuration[i] = static_cast<char>(tolower(configuration[i]));
+    }
+    return configuration;
+}
+
+std::string vhdl2hifParseLine::getCheckpointStage() { return getOption('k'); }
+
+std::string vhdl2hifParseLine::getResumeFile() { return getOption('r'); }
@@ -24,6 +24,13 @@
  * --------------------------------------------------------------------- */
 std::string yyfilename;
 int yycolumno = 1;
+bool yytraceEnabled = false;
+
+const std::string BLOCK_STATEMENT_PROPERTY       = "block_statement";
+const std::string AGGREGREGATE_INIDICES_PROPERTY = "AGGREGREGATE_INIDICES";
+const std::string RECOGNIZED_FCALL_PROPERTY      = "RECOGNIZED_FUNCTION_CALL";
+const std::string HIF_CONCURRENT_ASSERTION       = "HIF_CONCURRENT_ASSERTION";
+const std::string OPEN_PORTS_PROPERTY            = "OPEN_PORTS";
 
 using std::endl;
 using std::string;
@@ -168,14 +175,14 @@ void yywarning(char const *msg, Object *o)
     }
 }
 
-void yydebug(char const *msg, Object *o)
+void yytrace(char const *msg, Object *o)
 {
     assert(msg != nullptr);
-    (*debugStream) << " -- DEBUG: " << msg << " At line " << yylineno << ", column " << yycolumno << endl;
+    (*debugStream) << " -- DEBUG: " << msg << " At line " << yylineno << ", column " << yycolumno << '\n';
 
     if (o != nullptr) {
         hif::writeFile(*debugStream, o, false);
-        *debugStream << std::endl;
+        *debugStream << '\n';
     }
 }
 